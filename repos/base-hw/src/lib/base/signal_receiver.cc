@@ -145,6 +145,8 @@ void Signal_receiver::block_for_signal()
 		unsigned const num    = context->_curr_signal.num + data->num;
 		context->_pending     = true;
 		context->_curr_signal = Signal::Data(context, num);
+
+		_enqueue_ready(*context);
 	}
 
 	/* end kernel-aided life-time management */
@@ -155,21 +157,18 @@ void Signal_receiver::block_for_signal()
 Signal Signal_receiver::pending_signal()
 {
 	Mutex::Guard contexts_guard(_contexts_mutex);
-	Signal::Data result;
-	_contexts.for_each_locked([&] (Signal_context &context) {
 
-		if (!context._pending) return false;
+	if (Signal_context * const context = _dequeue_ready()) {
+
+		Mutex::Guard context_guard(context->_mutex);
+
+		Signal::Data const result = context->_curr_signal;
+
+		context->_pending     = false;
+		context->_curr_signal = Signal::Data(0, 0);
 
-		_contexts.head(context._next);
-		context._pending     = false;
-		result               = context._curr_signal;
-		context._curr_signal = Signal::Data(0, 0);
+		Trace::Signal_received trace_event(*context, result.num);
 
-		Trace::Signal_received trace_event(context, result.num);
-		return true;
-	});
-	if (result.context) {
-		Mutex::Guard context_guard(result.context->_mutex);
 		if (result.num == 0)
 			warning("returning signal with num == 0");
 
@@ -186,6 +185,7 @@ Signal Signal_receiver::pending_signal()
 		(Signal::Data *)Thread::myself()->utcb()->data();
 	Signal_context * const context = data->context;
 
+	Signal::Data result;
 	{
 		/* update signal context */
 		Mutex::Guard context_guard(context->_mutex);
@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__HEAP_H_
 
 #include <util/list.h>
+#include <util/avl_tree.h>
 #include <util/reconstructible.h>
 #include <base/ram_allocator.h>
 #include <region_map/region_map.h>
@@ -89,12 +90,57 @@ class Genode::Heap : public Allocator
 					ram_alloc = ram, region_map = rm; }
 		};
 
+		/*
+		 * Small blocks are allocated from bins of equally-sized entries.
+		 * Each bin holds page-sized blocks taken from the local allocator.
+		 * In contrast to the best-fit search of the AVL allocator, the
+		 * allocation and release of a bin entry take constant time. Bins
+		 * are used only if enabled via 'enable_bins'.
+		 */
+		struct Bin_block;
+
+		/*
+		 * Node of the registry of bin blocks, ordered by block address
+		 */
+		struct Bin_node : Avl_node<Bin_node>
+		{
+			/**
+			 * Return registered node at 'addr', or nullptr
+			 */
+			Bin_node *find_by_address(addr_t addr)
+			{
+				if (addr == (addr_t)this)
+					return this;
+
+				Bin_node * const c = child(addr > (addr_t)this);
+				return c ? c->find_by_address(addr) : nullptr;
+			}
+
+			/**
+			 * AVL node comparison function
+			 */
+			bool higher(Bin_node *other) { return (addr_t)other >= (addr_t)this; }
+		};
+
+		struct Bin
+		{
+			size_t     entry_size { 0 };
+			Bin_block *partial    { nullptr }; /* blocks with free entries */
+			Bin_block *spare      { nullptr }; /* cached empty block */
+		};
+
+		enum { NUM_BINS = 10, BIN_BLOCK_SIZE = 4096, BIN_BLOCK_HEADER = 128 };
+
 		Mutex                  mutable _mutex { };
 		Reconstructible<Allocator_avl> _alloc;        /* local allocator    */
 		Dataspace_pool                 _ds_pool;      /* list of dataspaces */
 		size_t                         _quota_limit { 0 };
 		size_t                         _quota_used  { 0 };
 		size_t                         _chunk_size  { 0 };
+		Bin                            _bins[NUM_BINS];
+		Avl_tree<Bin_node>             _bin_blocks { }; /* all bin blocks */
+
+		bool _bins_enabled { false };
 
 		/**
 		 * Allocate a new dataspace of the specified size
@@ -118,11 +164,41 @@ class Genode::Heap : public Allocator
 		 */
 		bool _try_local_alloc(size_t size, void **out_addr);
 
+		/**
+		 * Extend local allocator by a new dataspace that fits 'size' bytes
+		 *
+		 * \return true on success
+		 */
+		bool _grow(size_t size);
+
 		/**
 		 * Unsynchronized implementation of 'alloc'
 		 */
 		bool _unsynchronized_alloc(size_t size, void **out_addr);
 
+		/**
+		 * Return index of the bin serving blocks of 'size' bytes
+		 *
+		 * \return NUM_BINS if the size exceeds the largest bin or if bins
+		 *         are disabled
+		 */
+		unsigned _bin_index(size_t size) const;
+
+		/**
+		 * Return number of entries per block of bin
+		 */
+		static size_t _bin_entries(Bin const &bin) {
+			return (BIN_BLOCK_SIZE - BIN_BLOCK_HEADER) / bin.entry_size; }
+
+		/**
+		 * Return bin block that contains 'addr', or nullptr
+		 */
+		Bin_block *_bin_block(void *addr) const;
+
+		bool _bin_alloc(Bin &, void **out_addr);
+		void _bin_free(Bin_block &, void *addr);
+		void _release_bin_block(Bin_block &);
+
 	public:
 
 		enum { UNLIMITED = ~0 };
@@ -145,6 +221,23 @@ class Genode::Heap : public Allocator
 		 */
 		int quota_limit(size_t new_quota_limit);
 
+		/**
+		 * Serve small blocks from size-class bins
+		 *
+		 * Bins pay off for heaps with a high rate of small allocations like
+		 * the libc malloc heap. Each bin block is charged as a whole against
+		 * the quota limit and each bin keeps one empty block cached. Hence,
+		 * with bins enabled, 'consumed' includes the unused entries of all
+		 * bin blocks and the cached empty blocks. Heaps of sessions should
+		 * therefore not enable bins.
+		 * Bins cannot be disabled once enabled.
+		 */
+		void enable_bins()
+		{
+			Mutex::Guard guard(_mutex);
+			_bins_enabled = true;
+		}
+
 		/**
 		 * Re-assign RAM allocator and region map
 		 */
@@ -170,7 +263,7 @@ class Genode::Heap : public Allocator
 		bool   alloc(size_t, void **) override;
 		void   free(void *, size_t) override;
 		size_t consumed() const override { return _quota_used; }
-		size_t overhead(size_t size) const override { return _alloc->overhead(size); }
+		size_t overhead(size_t size) const override;
 		bool   need_size_for_free() const override { return false; }
 };
 
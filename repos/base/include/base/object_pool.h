@@ -17,6 +17,7 @@
 #define _INCLUDE__BASE__OBJECT_POOL_H_
 
 #include <util/avl_tree.h>
+#include <util/hash.h>
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/mutex.h>
@@ -95,29 +96,56 @@ class Genode::Object_pool : Interface, Noncopyable
 
 	private:
 
-		Avl_tree<Entry> _tree { };
-		Mutex           _mutex { };
+		/*
+		 * The entries are distributed over buckets by the hash of their
+		 * capability's local name. Each bucket is protected by a mutex of
+		 * its own, which relieves entrypoints that dispatch RPCs to
+		 * different objects of the same pool from contending for a single
+		 * mutex and keeps the trees shallow for pools with many objects.
+		 */
+		enum { NUM_BUCKETS_LOG2 = 4, NUM_BUCKETS = 1 << NUM_BUCKETS_LOG2 };
+
+		struct Bucket
+		{
+			Avl_tree<Entry> tree  { };
+			Mutex           mutex { };
+		};
+
+		Bucket _buckets[NUM_BUCKETS];
+
+		Bucket &_bucket(unsigned long obj_id) {
+			return _buckets[multiplicative_hash<NUM_BUCKETS_LOG2>(obj_id)]; }
 
 	protected:
 
 		bool empty()
 		{
-			Mutex::Guard lock_guard(_mutex);
-			return _tree.first() == nullptr;
+			for (Bucket &bucket : _buckets) {
+				Mutex::Guard lock_guard(bucket.mutex);
+				if (bucket.tree.first())
+					return false;
+			}
+			return true;
 		}
 
 	public:
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Mutex::Guard lock_guard(_mutex);
-			_tree.insert(obj);
+			Entry &entry = *obj;
+			Bucket &bucket = _bucket(entry._obj_id());
+
+			Mutex::Guard lock_guard(bucket.mutex);
+			bucket.tree.insert(&entry);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Mutex::Guard lock_guard(_mutex);
-			_tree.remove(obj);
+			Entry &entry = *obj;
+			Bucket &bucket = _bucket(entry._obj_id());
+
+			Mutex::Guard lock_guard(bucket.mutex);
+			bucket.tree.remove(&entry);
 		}
 
 		template <typename FUNC>
@@ -132,10 +160,12 @@ class Genode::Object_pool : Interface, Noncopyable
 			Weak_ptr ptr;
 
 			{
-				Mutex::Guard lock_guard(_mutex);
+				Bucket &bucket = _bucket(capid);
+
+				Mutex::Guard lock_guard(bucket.mutex);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = bucket.tree.first() ?
+					bucket.tree.first()->find_by_obj_id(capid) : nullptr;
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -161,24 +191,26 @@ class Genode::Object_pool : Interface, Noncopyable
 			using Weak_ptr   = Weak_ptr<typename Entry::Entry_lock>;
 			using Locked_ptr = Locked_ptr<typename Entry::Entry_lock>;
 
-			for (;;) {
-				OBJ_TYPE * obj;
+			for (Bucket &bucket : _buckets) {
+				for (;;) {
+					OBJ_TYPE * obj;
 
-				{
-					Mutex::Guard lock_guard(_mutex);
+					{
+						Mutex::Guard lock_guard(bucket.mutex);
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+						if (!((obj = (OBJ_TYPE*) bucket.tree.first()))) break;
 
-					Weak_ptr ptr = obj->_lock.weak_ptr();
-					{
-						Locked_ptr lock_ptr(ptr);
-						if (!lock_ptr.valid()) return;
+						Weak_ptr ptr = obj->_lock.weak_ptr();
+						{
+							Locked_ptr lock_ptr(ptr);
+							if (!lock_ptr.valid()) return;
 
-						_tree.remove(obj);
+							bucket.tree.remove(obj);
+						}
 					}
-				}
 
-				func(obj);
+					func(obj);
+				}
 			}
 		}
 };
@@ -19,6 +19,7 @@
 
 #include <util/noncopyable.h>
 #include <util/list.h>
+#include <util/fifo.h>
 #include <base/semaphore.h>
 #include <base/capability.h>
 
@@ -206,6 +207,11 @@ class Genode::Signal_context : Interface, Noncopyable
 		 */
 		List_element<Signal_context> _deferred_le { this };
 
+		/**
+		 * Queue element in the receiver's queue of pending contexts
+		 */
+		Fifo_element<Signal_context> _ready_fe { *this };
+
 		/**
 		 * Receiver to which the context is associated with
 		 *
@@ -279,7 +285,7 @@ class Genode::Signal_receiver : Noncopyable
 	private:
 
 		/**
-		 * A list where the head can be moved
+		 * Ring of associated contexts
 		 */
 		class Context_ring
 		{
@@ -289,28 +295,11 @@ class Genode::Signal_receiver : Noncopyable
 
 			public:
 
-				struct Break_for_each : Exception { };
-
 				Signal_context *head() const { return _head; }
 
-				void head(Signal_context *re) { _head = re; }
-
 				void insert_as_tail(Signal_context *re);
 
 				void remove(Signal_context const *re);
-
-				template <typename FUNC>
-				void for_each_locked(FUNC && functor) const
-				{
-					Signal_context *context = _head;
-					if (!context) return;
-
-					do {
-						Mutex::Guard mutex_guard(context->_mutex);
-						if (functor(*context)) return;
-						context = context->_next;
-					} while (context != _head);
-				}
 		};
 
 		/**
@@ -331,6 +320,29 @@ class Genode::Signal_receiver : Noncopyable
 		Mutex        _contexts_mutex { };
 		Context_ring _contexts       { };
 
+		/**
+		 * Queue of contexts with pending signals
+		 *
+		 * The queue lets 'pending_signal' pick the next pending context
+		 * without visiting all associated contexts. Contexts are served in
+		 * the order in which they became pending. No other mutex is
+		 * acquired while holding '_ready_mutex'.
+		 */
+		Mutex                              _ready_mutex { };
+		Fifo<Fifo_element<Signal_context>> _ready       { };
+
+		/**
+		 * Enqueue context that became pending
+		 */
+		void _enqueue_ready(Signal_context &);
+
+		/**
+		 * Dequeue the context that became pending first
+		 *
+		 * \return  context, or nullptr if no context is pending
+		 */
+		Signal_context *_dequeue_ready();
+
 		/**
 		 * Helper to dissolve given context
 		 *
@@ -16,20 +16,40 @@
 
 #include <base/stdint.h>
 #include <cpu_session/cpu_session.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode { namespace Trace { class Buffer; } }
 
 
 /**
  * Buffer shared between CPU client thread and TRACE client
+ *
+ * By default, the buffer is a ring that is overwritten by the CPU client
+ * regardless of the progress of the TRACE client, which merely learns about
+ * lost entries by the wrap count. Alternatively, the TRACE client may switch
+ * the buffer to lossless streaming via 'stream_lossless'. In this mode, the
+ * TRACE client publishes its read position ('tail') after consuming a batch
+ * of entries and the CPU client never overwrites unconsumed entries. Events
+ * that do not fit are dropped and counted instead.
  */
 class Genode::Trace::Buffer
 {
 	private:
 
+		/*
+		 * Members written by the CPU client
+		 */
 		unsigned volatile _head_offset;  /* in bytes, relative to 'entries' */
 		unsigned volatile _size;         /* in bytes */
 		unsigned volatile _wrapped;      /* count of buffer wraps */
+		unsigned volatile _dropped;      /* count of dropped entries */
+
+		/*
+		 * Members written by the TRACE client
+		 */
+		unsigned volatile _lossless;     /* lossless streaming enabled */
+		unsigned volatile _tail_offset;  /* in bytes, relative to 'entries' */
+		unsigned volatile _tail_wrapped; /* count of consumed buffer wraps */
 
 		struct _Entry
 		{
@@ -41,6 +61,31 @@ class Genode::Trace::Buffer
 
 		_Entry *_head_entry() { return (_Entry *)((addr_t)_entries + _head_offset); }
 
+		_Entry const *_entry_at(unsigned offset) const {
+			return (_Entry const *)((addr_t)_entries + offset); }
+
+		/**
+		 * Return true if an entry of 'len' bytes plus the terminating
+		 * entry fits in lossless mode without touching unconsumed entries
+		 *
+		 * \param wrap  true if the entry is placed at the buffer start
+		 *
+		 * The CPU client never catches up with the tail entirely, which
+		 * leaves 'tail <= head' as unambiguous indication that the
+		 * TRACE client operates on the same buffer wrap as the CPU client.
+		 */
+		bool _fits_lossless(size_t len, bool wrap) const
+		{
+			unsigned const tail = _tail_offset;
+			size_t   const need = 2*sizeof(_Entry) + len;
+
+			/* TRACE client still operates on the previous buffer wrap */
+			if (tail > _head_offset)
+				return !wrap && (_head_offset + need <= tail);
+
+			return wrap ? (need <= tail) : true;
+		}
+
 		void _buffer_wrapped()
 		{
 			_head_offset = 0;
@@ -63,25 +108,53 @@ class Genode::Trace::Buffer
 
 		void init(size_t size)
 		{
-			_head_offset = 0;
-
 			/* compute number of bytes available for tracing data */
 			size_t const header_size = (addr_t)&_entries - (addr_t)this;
 
-			_size = size - header_size;
+			/*
+			 * Keep the state of an already initialized buffer in lossless
+			 * mode, which may still contain unconsumed entries when the
+			 * CPU client re-attaches the buffer on a policy change.
+			 */
+			if (_lossless && _size == size - header_size)
+				return;
 
-			_wrapped = 0;
+			_head_offset = 0;
+			_size        = size - header_size;
+			_wrapped     = 0;
+			_dropped     = 0;
 		}
 
+		/**
+		 * Reserve space for an entry of 'len' bytes
+		 *
+		 * \return  pointer to entry data, or nullptr if the entry must be
+		 *          dropped because the buffer is in lossless mode and the
+		 *          TRACE client did not consume enough entries yet
+		 */
 		char *reserve(size_t len)
 		{
-			if (_head_offset + sizeof(_Entry) + len <= _size)
-				return _head_entry()->data;
+			bool const lossless = _lossless;
+
+			if (_head_offset + sizeof(_Entry) + len <= _size) {
+
+				if (!lossless || _fits_lossless(len, false))
+					return _head_entry()->data;
+
+				_dropped++;
+				return nullptr;
+			}
+
+			if (lossless && !_fits_lossless(len, true)) {
+				_dropped++;
+				return nullptr;
+			}
 
 			/* mark last entry with len 0 and wrap */
 			if (_head_offset + sizeof(_Entry) <= _size)
 				_head_entry()->len = 0;
 
+			memory_barrier();
 			_buffer_wrapped();
 
 			return _head_entry()->data;
@@ -93,20 +166,38 @@ class Genode::Trace::Buffer
 			if (len == 0)
 				return;
 
-			_head_entry()->len = len;
+			unsigned const next_offset =
+				_head_offset + (unsigned)(sizeof(_Entry) + len);
 
-			/* advance head offset, wrap when reaching buffer boundary */
-			_head_offset += sizeof(_Entry) + len;
-			if (_head_offset == _size)
-				_buffer_wrapped();
+			/*
+			 * Mark entry next to new entry with len 0 before publishing the
+			 * new entry so that a concurrent TRACE client never steps onto
+			 * the stale length of an entry of a previous buffer wrap.
+			 */
+			if (next_offset + sizeof(_Entry) <= _size)
+				((_Entry *)((addr_t)_entries + next_offset))->len = 0;
 
-			/* mark entry next to new entry with len 0 */
-			else if (_head_offset + sizeof(_Entry) <= _size)
-				_head_entry()->len = 0;
+			memory_barrier();
+			_head_entry()->len = len;
+			memory_barrier();
+
+			/*
+			 * Advance head offset, wrap when reaching buffer boundary. In
+			 * lossless mode, the wrap is deferred to the next 'reserve'
+			 * because the first entry may not be consumed yet.
+			 */
+			_head_offset = next_offset;
+			if (_head_offset == _size && !_lossless)
+				_buffer_wrapped();
 		}
 
 		unsigned wrapped() const { return _wrapped; }
 
+		/**
+		 * Number of entries dropped in lossless mode
+		 */
+		unsigned dropped() const { return _dropped; }
+
 
 		/********************************************
 		 ** Functions called from the TRACE client **
@@ -176,6 +267,92 @@ class Genode::Trace::Buffer
 
 			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
 		}
+
+		/**
+		 * Switch buffer to lossless streaming
+		 *
+		 * The TRACE client should call this method right after attaching
+		 * the buffer. Consumption starts at the current head of the
+		 * buffer. Entries produced before are skipped.
+		 */
+		void stream_lossless()
+		{
+			if (_lossless)
+				return;
+
+			/* obtain consistent snapshot of the head position */
+			unsigned wrapped, head;
+			do {
+				wrapped = _wrapped;
+				head    = _head_offset;
+			} while (wrapped != _wrapped);
+
+			_tail_wrapped = wrapped;
+			_tail_offset  = head;
+
+			memory_barrier();
+			_lossless = 1;
+		}
+
+		bool lossless() const { return _lossless; }
+
+		/**
+		 * Call 'fn' for each entry not consumed so far in lossless mode
+		 *
+		 * \param fn   functor called with an 'Entry const &' argument
+		 * \param max  maximum number of entries to consume
+		 *
+		 * \return  number of consumed entries
+		 *
+		 * The entries are passed in place without copying. Hence, the
+		 * functor must not keep references to the entry data. The read
+		 * position is published to the CPU client once per batch, which
+		 * makes the space of all consumed entries available again.
+		 */
+		template <typename FN>
+		unsigned for_each_new_entry(FN const &fn, unsigned max = ~0U)
+		{
+			if (!_lossless)
+				return 0;
+
+			unsigned tail    = _tail_offset;
+			unsigned wrapped = _tail_wrapped;
+			unsigned count   = 0;
+
+			while (count < max) {
+
+				bool const producer_wrapped = (_wrapped != wrapped);
+				memory_barrier();
+
+				/* end of the buffer, or padding in front of a wrap */
+				bool const at_end = (tail + sizeof(_Entry) > _size)
+				                 || (_entry_at(tail)->len == 0);
+
+				if (at_end) {
+					if (!producer_wrapped)
+						break;
+
+					tail = 0;
+					wrapped++;
+					continue;
+				}
+
+				memory_barrier();
+
+				_Entry const &e = *_entry_at(tail);
+				fn(Entry(&e));
+
+				tail += (unsigned)(sizeof(_Entry) + e.len);
+				count++;
+			}
+
+			/* publish the read position to the CPU client */
+			memory_barrier();
+			_tail_wrapped = wrapped;
+			_tail_offset  = tail;
+
+			return count;
+		}
 };
 
 #endif /* _INCLUDE__BASE__TRACE__BUFFER_H_ */
@@ -83,7 +83,11 @@ struct Genode::Trace::Logger
 		{
 			if (!this || !_evaluate_control()) return;
 
-			buffer->commit(event->generate(*policy_module, buffer->reserve(max_event_size)));
+			/* the buffer may refuse the event in lossless mode */
+			char * const dst = buffer->reserve(max_event_size);
+			if (!dst) return;
+
+			buffer->commit(event->generate(*policy_module, dst));
 		}
 };
 
@@ -0,0 +1,62 @@
+/*
+ * \brief  Measurement of durations and operation rates
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TIMER__STOPWATCH_H_
+#define _TIMER__STOPWATCH_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <timer_session/timer_session.h>
+
+namespace Timer { class Stopwatch; }
+
+
+class Timer::Stopwatch : Genode::Noncopyable
+{
+	private:
+
+		Session const &_timer;
+
+		Genode::uint64_t _start_us { _timer.elapsed_us() };
+
+	public:
+
+		Stopwatch(Session const &timer) : _timer(timer) { }
+
+		void restart() { _start_us = _timer.elapsed_us(); }
+
+		/**
+		 * Return microseconds passed since construction or last 'restart'
+		 */
+		Genode::uint64_t elapsed_us() const {
+			return _timer.elapsed_us() - _start_us; }
+
+		/**
+		 * Return microseconds spent in 'fn'
+		 */
+		template <typename FN>
+		Genode::uint64_t measure_us(FN const &fn)
+		{
+			restart();
+			fn();
+			return elapsed_us();
+		}
+
+		/**
+		 * Return number of operations per second
+		 */
+		static Genode::uint64_t rate(Genode::uint64_t ops, Genode::uint64_t us) {
+			return us ? ops*1000*1000/us : 0; }
+};
+
+#endif /* _TIMER__STOPWATCH_H_ */
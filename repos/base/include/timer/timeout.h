@@ -22,6 +22,7 @@
 /* Genode includes */
 #include <util/noncopyable.h>
 #include <util/list.h>
+#include <util/avl_tree.h>
 #include <base/duration.h>
 #include <base/mutex.h>
 #include <util/misc_math.h>
@@ -85,8 +86,7 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : public Genode::Avl_node<Timeout>
 {
 	friend class Timeout_scheduler;
 
@@ -99,6 +99,7 @@ class Genode::Timeout : private Noncopyable,
 		List_element<Timeout>  _pending_timeouts_le { this };
 		Timeout_handler       *_pending_handler     { nullptr };
 		Timeout_handler       *_handler             { nullptr };
+		bool                   _in_timeouts         { false };
 		bool                   _in_discard_blockade { false };
 		Blockade               _discard_blockade    { };
 
@@ -123,11 +124,25 @@ class Genode::Timeout : private Noncopyable,
 		void discard();
 
 		bool scheduled();
+
+
+		/**************
+		 ** Avl_node **
+		 **************/
+
+		bool higher(Timeout *other)
+		{
+			return other->_deadline.value >= _deadline.value;
+		}
 };
 
 
 /**
  * Multiplexes one time source amongst different timeouts
+ *
+ * The scheduled timeouts are kept in an AVL tree ordered by deadline, which
+ * makes scheduling and discarding a timeout O(log n) in the number of
+ * scheduled timeouts.
  */
 class Genode::Timeout_scheduler : private Noncopyable,
                                   public  Timeout_handler
@@ -143,13 +158,20 @@ class Genode::Timeout_scheduler : private Noncopyable,
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
+		Avl_tree<Timeout>   _timeouts           { };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
+		void _insert_into_timeouts(Timeout &timeout);
+
+		void _remove_from_timeouts(Timeout &timeout);
+
+		/**
+		 * Return timeout with the earliest deadline or nullptr
+		 */
+		Timeout *_first_timeout() const;
 
 		void _set_time_source_timeout();
 
@@ -0,0 +1,41 @@
+/*
+ * \brief  Hashing of integer values
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__HASH_H_
+#define _INCLUDE__UTIL__HASH_H_
+
+namespace Genode {
+
+	/**
+	 * Return 'BITS'-bit hash of 'value'
+	 *
+	 * Multiplicative hashing with the golden ratio, using the upper bits of
+	 * the product. Those bits depend on all bits of 'value', which makes the
+	 * hash suitable for values with constant low bits like the addresses of
+	 * aligned objects.
+	 */
+	template <unsigned BITS>
+	static constexpr unsigned long multiplicative_hash(unsigned long value)
+	{
+		static_assert(BITS > 0 && BITS < 8*sizeof(unsigned long),
+		              "invalid number of hash bits");
+
+		unsigned long const golden_ratio = sizeof(unsigned long) == 8
+		                                 ? (unsigned long)0x9e3779b97f4a7c15ULL
+		                                 : (unsigned long)0x9e3779b9UL;
+
+		return (value*golden_ratio) >> (8*sizeof(unsigned long) - BITS);
+	}
+}
+
+#endif /* _INCLUDE__UTIL__HASH_H_ */
@@ -0,0 +1,101 @@
+/*
+ * \brief  Pre-computed index of an XML document
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * A plain 'Xml_node' does not keep any state besides the location of its
+ * start and end tags. Each navigation step like 'sub_node' or 'next'
+ * re-scans the document. For large configs or reports that are traversed
+ * repeatedly, the 'Xml_index' records the structure of the document in one
+ * pass. Nodes obtained via 'Xml_index::xml' navigate via the index while
+ * providing the same interface as non-indexed nodes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <base/allocator.h>
+
+namespace Genode { class Xml_index; }
+
+
+class Genode::Xml_index
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Xml_index(Xml_index const &);
+		Xml_index &operator = (Xml_index const &);
+
+		Allocator &_alloc;
+
+		char const * const _addr;
+		size_t       const _max_len;
+
+		unsigned const _num_nodes;
+
+		Xml_index_entry * const _entries;
+
+		Xml_index_entry *_alloc_entries()
+		{
+			Xml_index_entry *entries = (Xml_index_entry *)
+				_alloc.alloc(_num_nodes*sizeof(Xml_index_entry));
+
+			try {
+				Xml_node::_build_index(_addr, _max_len, entries, _num_nodes);
+			} catch (...) {
+				_alloc.free(entries, _num_nodes*sizeof(Xml_index_entry));
+				throw;
+			}
+			return entries;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * The XML data must remain unchanged during the lifetime of the
+		 * index. E.g., the index of an 'Attached_rom_dataspace' must be
+		 * re-created after each 'update'.
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Xml_index(Allocator &alloc, char const *addr, size_t max_len)
+		:
+			_alloc(alloc), _addr(addr), _max_len(max_len),
+			_num_nodes(Xml_node::_build_index(addr, max_len, nullptr, 0)),
+			_entries(_alloc_entries())
+		{ }
+
+		/**
+		 * Constructor for indexing the given XML node
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			Xml_index(alloc, node._addr, node.size())
+		{ }
+
+		~Xml_index() { _alloc.free(_entries, _num_nodes*sizeof(Xml_index_entry)); }
+
+		/**
+		 * Return indexed top-level node
+		 */
+		Xml_node xml() const { return Xml_node(_addr, _max_len, _entries, 0); }
+
+		unsigned num_nodes() const { return _num_nodes; }
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
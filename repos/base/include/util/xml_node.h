@@ -23,6 +23,8 @@ namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
 	class Xml_unquoted;
+	class Xml_index;
+	struct Xml_index_entry;
 }
 
 
@@ -198,6 +200,27 @@ class Genode::Xml_attribute
 };
 
 
+/**
+ * Node of a pre-computed index of an XML document
+ *
+ * The index is created by 'Xml_index' (util/xml_index.h). Offsets are
+ * relative to the start of the document.
+ */
+struct Genode::Xml_index_entry
+{
+	enum : unsigned { NONE = ~0U };
+
+	size_t   node_offset;     /* start of the data of the 'Xml_node' */
+	size_t   start_offset;    /* start tag */
+	size_t   end_offset;      /* end tag, same as start tag if empty */
+	unsigned parent;
+	unsigned num_sub_nodes;
+	unsigned first_sub_node;
+	unsigned last_sub_node;
+	unsigned next_sibling;
+};
+
+
 /**
  * Representation of an XML node
  */
@@ -213,6 +236,7 @@ class Genode::Xml_node
 		class Tag;
 
 		friend class Xml_unquoted;
+		friend class Xml_index;
 
 	public:
 
@@ -578,8 +602,178 @@ class Genode::Xml_node
 				start(skip_non_tag_characters(Token(addr, max_len))),
 				end(_search_end_tag(start, num_sub_nodes))
 			{ }
+
+			/**
+			 * Constructor used for indexed nodes, which skips the search
+			 */
+			Tags(char const *doc, size_t doc_len, Xml_index_entry const &e)
+			:
+				num_sub_nodes((int)e.num_sub_nodes),
+				start(Token(doc + e.start_offset, doc_len - e.start_offset)),
+				end(Token(doc + e.end_offset, doc_len - e.end_offset))
+			{ }
 		} _tags;
 
+		/*
+		 * Index of the document, or nullptr if the node is not indexed
+		 */
+		Xml_index_entry const *_index     { nullptr };
+		unsigned               _index_pos { 0 };
+
+		Xml_index_entry const &_entry() const { return _index[_index_pos]; }
+
+		/**
+		 * Return indexed node at position 'pos' of the index
+		 */
+		Xml_node _indexed_node(unsigned pos) const
+		{
+			char const  *doc     = _addr    - _entry().node_offset;
+			size_t const doc_len = _max_len + _entry().node_offset;
+
+			return Xml_node(doc, doc_len, _index, pos);
+		}
+
+		/**
+		 * Return next sibling of specified type in index, or 'NONE'
+		 */
+		unsigned _indexed_sibling(unsigned pos, char const *type) const
+		{
+			for (; pos != Xml_index_entry::NONE; pos = _index[pos].next_sibling)
+				if (!type || _indexed_node(pos).has_type(type))
+					return pos;
+
+			return Xml_index_entry::NONE;
+		}
+
+		/**
+		 * Constructor of indexed node
+		 */
+		Xml_node(char const *doc, size_t doc_len,
+		         Xml_index_entry const *index, unsigned pos)
+		:
+			_addr(doc + index[pos].node_offset),
+			_max_len(doc_len - index[pos].node_offset),
+			_tags(doc, doc_len, index[pos]),
+			_index(index), _index_pos(pos)
+		{ }
+
+		/**
+		 * Create index of the XML node at 'addr' in one pass
+		 *
+		 * If 'entries' is nullptr, the nodes are only counted. In contrast
+		 * to the lazy validation of a non-indexed node, the entire node
+		 * is checked for matching start and end tags.
+		 *
+		 * \throw Invalid_syntax
+		 * \return number of nodes
+		 */
+		static unsigned _build_index(char const *addr, size_t max_len,
+		                             Xml_index_entry *entries, unsigned max_entries)
+		{
+			unsigned const NONE = Xml_index_entry::NONE;
+
+			auto offset = [&] (Token t) { return (size_t)(t.start() - addr); };
+
+			auto tag_at = [&] (size_t offset) {
+				return Tag(Token(addr + offset, max_len - offset)); };
+
+			Tag const root(skip_non_tag_characters(Token(addr, max_len)));
+			if (root.type() != Tag::START && root.type() != Tag::EMPTY)
+				throw Invalid_syntax();
+
+			unsigned count = 0;
+			unsigned depth = 0;
+			unsigned curr  = NONE;
+
+			auto add = [&] (Tag const &tag, size_t node_offset)
+			{
+				unsigned const pos = count++;
+
+				if (entries) {
+					if (pos >= max_entries)
+						throw Invalid_syntax();
+
+					entries[pos] = { node_offset, offset(tag.token()),
+					                 offset(tag.token()), curr,
+					                 0, NONE, NONE, NONE };
+
+					if (curr != NONE) {
+						Xml_index_entry &parent = entries[curr];
+						if (parent.last_sub_node == NONE)
+							parent.first_sub_node = pos;
+						else
+							entries[parent.last_sub_node].next_sibling = pos;
+
+						parent.last_sub_node = pos;
+						parent.num_sub_nodes++;
+					}
+				}
+
+				if (tag.type() == Tag::START) {
+					curr = pos;
+					depth++;
+				}
+			};
+
+			add(root, 0);
+
+			Token t = root.next_token();
+			while (depth > 0 && t.type() != Token::END) {
+
+				Comment const comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag const tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				if (tag.type() != Tag::END) {
+
+					/*
+					 * Like for non-indexed nodes, the data of the first sub
+					 * node starts at the content of its parent and the data
+					 * of a further sibling at its start tag.
+					 */
+					size_t node_offset = 0;
+					if (entries) {
+						unsigned const prev = entries[curr].last_sub_node;
+						node_offset = (prev == NONE)
+						            ? offset(tag_at(entries[curr].start_offset).next_token())
+						            : offset(tag.token());
+					}
+
+					add(tag, node_offset);
+				}
+				else {
+					depth--;
+
+					if (entries) {
+						Token const start_name =
+							tag_at(entries[curr].start_offset).name();
+
+						if (start_name.len() != tag.name().len()
+						 || strcmp(start_name.start(), tag.name().start(),
+						           start_name.len()))
+							throw Invalid_syntax();
+
+						entries[curr].end_offset = offset(tag.token());
+						curr = entries[curr].parent;
+					}
+				}
+				t = tag.next_token();
+			}
+
+			if (depth > 0)
+				throw Invalid_syntax();
+
+			return count;
+		}
+
 		/**
 		 * Return true if specified buffer contains a valid XML node
 		 */
@@ -752,6 +946,14 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			if (_index) {
+				unsigned const pos = _entry().next_sibling;
+				if (pos == Xml_index_entry::NONE)
+					throw Nonexistent_sub_node();
+
+				return _indexed_node(pos);
+			}
+
 			Token after_node = _tags.end.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try {
@@ -779,6 +981,10 @@ class Genode::Xml_node
 		 */
 		bool last(char const *type = nullptr) const
 		{
+			if (_index)
+				return _indexed_sibling(_entry().next_sibling, type)
+				       == Xml_index_entry::NONE;
+
 			Token after = _tags.end.next_token();
 			after = skip_non_tag_characters(after);
 
@@ -804,6 +1010,17 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_index) {
+				unsigned pos = _entry().first_sub_node;
+				for (; idx > 0 && pos != Xml_index_entry::NONE; idx--)
+					pos = _index[pos].next_sibling;
+
+				if (pos == Xml_index_entry::NONE)
+					throw Nonexistent_sub_node();
+
+				return _indexed_node(pos);
+			}
+
 			if (_tags.num_sub_nodes > 0) {
 				try {
 					Xml_node curr_node = _node_at(_content_base());
@@ -822,6 +1039,14 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(char const *type) const
 		{
+			if (_index) {
+				unsigned const pos = _indexed_sibling(_entry().first_sub_node, type);
+				if (pos == Xml_index_entry::NONE)
+					throw Nonexistent_sub_node();
+
+				return _indexed_node(pos);
+			}
+
 			if (_tags.num_sub_nodes > 0) {
 
 				/* search for sub node of specified type */
@@ -980,6 +1205,10 @@ class Genode::Xml_node
 			if (_tags.num_sub_nodes == 0)
 				return false;
 
+			if (_index)
+				return _indexed_sibling(_entry().first_sub_node, type)
+				       != Xml_index_entry::NONE;
+
 			if (!_valid_node_at(_content_base()))
 				return false;
 
@@ -32,9 +32,82 @@ namespace {
 		 */
 		BIG_ALLOCATION_THRESHOLD = 64*1024 /* in bytes */
 	};
+
+	/*
+	 * Entry sizes of the bins, multiples of 16 to preserve the alignment
+	 * of the blocks allocated from the AVL allocator
+	 */
+	static Genode::size_t const bin_entry_sizes[] = {
+		16, 32, 48, 64, 96, 128, 192, 256, 384, 512 };
 }
 
 
+/**
+ * Page-sized block of equally-sized entries of a bin
+ *
+ * The header is located at the beginning of the block. Since entries never
+ * start at the block boundary, the header of the block containing an entry
+ * is found by truncating the entry address to the block size. Whether the
+ * truncated address actually refers to a bin block is decided by the
+ * heap's registry of bin blocks. In contrast to a marker within the page,
+ * the registry cannot be forged by data stored in heap-allocated blocks.
+ */
+struct Genode::Heap::Bin_block : Bin_node
+{
+	enum { MAX_ENTRIES = (BIN_BLOCK_SIZE - BIN_BLOCK_HEADER) / 16,
+	       BITS        = sizeof(addr_t)*8 };
+
+	Bin         &bin;
+	Bin_block   *prev      = nullptr;
+	Bin_block   *next      = nullptr;
+	void        *free_list = nullptr;  /* linked through the first word */
+	unsigned     used      = 0;
+
+	/* used entries, for detecting double frees */
+	addr_t used_bits[MAX_ENTRIES / BITS + 1] { };
+
+	Bin_block(Bin &bin) : bin(bin)
+	{
+		/* thread all entries into free list, lowest address first */
+		for (size_t i = _bin_entries(bin); i > 0; i--) {
+			void **entry = (void **)entry_addr(i - 1);
+			*entry    = free_list;
+			free_list = entry;
+		}
+	}
+
+	addr_t entry_addr(size_t index) const {
+		return (addr_t)this + BIN_BLOCK_HEADER + index*bin.entry_size; }
+
+	/**
+	 * Return index of entry at 'addr', or ~0UL for an invalid address
+	 */
+	size_t entry_index(void *addr) const
+	{
+		addr_t const offset = (addr_t)addr - entry_addr(0);
+
+		if (offset % bin.entry_size || offset / bin.entry_size >= _bin_entries(bin))
+			return ~0UL;
+
+		return offset / bin.entry_size;
+	}
+
+	bool used_entry(size_t i) const { return used_bits[i / BITS] & (1UL << (i % BITS)); }
+
+	void mark_used(size_t i, bool used)
+	{
+		if (used) used_bits[i / BITS] |=  (1UL << (i % BITS));
+		else      used_bits[i / BITS] &= ~(1UL << (i % BITS));
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Bin_block(Bin_block const &);
+	Bin_block &operator = (Bin_block const &);
+};
+
+
 void Heap::Dataspace_pool::remove_and_free(Dataspace &ds)
 {
 	/*
@@ -147,6 +220,39 @@ bool Heap::_try_local_alloc(size_t size, void **out_addr)
 }
 
 
+bool Heap::_grow(size_t size)
+{
+	/*
+	 * Calculate block size of needed backing store. The block must hold the
+	 * requested 'size' and we add some space for meta data
+	 * ('Dataspace' structures, AVL-node slab blocks).
+	 * Finally, we align the size to a 4K page.
+	 */
+	size_t dataspace_size = size + Allocator_avl::slab_block_size() + sizeof(Heap::Dataspace);
+
+	/*
+	 * '_chunk_size' is a multiple of 4K, so 'dataspace_size' becomes
+	 * 4K-aligned, too.
+	 */
+	size_t const request_size = _chunk_size * sizeof(umword_t);
+
+	if ((dataspace_size < request_size) &&
+		_allocate_dataspace(request_size, false)) {
+
+		/*
+		 * Exponentially increase chunk size with each allocated chunk until
+		 * we hit 'MAX_CHUNK_SIZE'.
+		 */
+		_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
+		return true;
+	}
+
+	/* align to 4K page */
+	dataspace_size = align_addr(dataspace_size, 12);
+	return _allocate_dataspace(dataspace_size, false) != nullptr;
+}
+
+
 bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 {
 	size_t dataspace_size;
@@ -181,39 +287,144 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 	if (_try_local_alloc(size, out_addr))
 		return true;
 
-	/*
-	 * Calculate block size of needed backing store. The block must hold the
-	 * requested 'size' and we add some space for meta data
-	 * ('Dataspace' structures, AVL-node slab blocks).
-	 * Finally, we align the size to a 4K page.
-	 */
-	dataspace_size = size + Allocator_avl::slab_block_size() + sizeof(Heap::Dataspace);
+	if (!_grow(size))
+		return false;
+
+	/* allocate originally requested block */
+	return _try_local_alloc(size, out_addr);
+}
+
+
+unsigned Heap::_bin_index(size_t size) const
+{
+	if (!_bins_enabled)
+		return NUM_BINS;
+
+	unsigned i = 0;
+	for (; i < NUM_BINS && size > bin_entry_sizes[i]; i++);
+	return i;
+}
+
+
+Heap::Bin_block *Heap::_bin_block(void *addr) const
+{
+	addr_t const block_addr = (addr_t)addr & ~((addr_t)BIN_BLOCK_SIZE - 1);
 
 	/*
-	 * '_chunk_size' is a multiple of 4K, so 'dataspace_size' becomes
-	 * 4K-aligned, too.
+	 * Bin entries never start at the block boundary, which also excludes
+	 * big allocations and blocks at page boundaries.
 	 */
-	size_t const request_size = _chunk_size * sizeof(umword_t);
+	if (block_addr == (addr_t)addr)
+		return nullptr;
 
-	if ((dataspace_size < request_size) &&
-		_allocate_dataspace(request_size, false)) {
+	Bin_node * const first = _bin_blocks.first();
+	return first ? static_cast<Bin_block *>(first->find_by_address(block_addr))
+	             : nullptr;
+}
 
-		/*
-		 * Exponentially increase chunk size with each allocated chunk until
-		 * we hit 'MAX_CHUNK_SIZE'.
-		 */
-		_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
 
-	} else {
+bool Heap::_bin_alloc(Bin &bin, void **out_addr)
+{
+	if (!bin.partial) {
 
-		/* align to 4K page */
-		dataspace_size = align_addr(dataspace_size, 12);
-		if (!_allocate_dataspace(dataspace_size, false))
-			return false;
+		Bin_block *block = bin.spare;
+		bin.spare = nullptr;
+
+		if (!block) {
+			void *addr = nullptr;
+
+			if (BIN_BLOCK_SIZE + _quota_used > _quota_limit)
+				return false;
+
+			/* the alignment may waste up to one block */
+			if (_alloc->alloc_aligned(BIN_BLOCK_SIZE, &addr, log2((size_t)BIN_BLOCK_SIZE)).error()) {
+
+				if (!_grow(2*BIN_BLOCK_SIZE))
+					return false;
+
+				if (_alloc->alloc_aligned(BIN_BLOCK_SIZE, &addr, log2((size_t)BIN_BLOCK_SIZE)).error())
+					return false;
+			}
+
+			block = construct_at<Bin_block>(addr, bin);
+			_bin_blocks.insert(block);
+			_quota_used += BIN_BLOCK_SIZE;
+		}
+
+		bin.partial = block;
 	}
 
-	/* allocate originally requested block */
-	return _try_local_alloc(size, out_addr);
+	Bin_block &block = *bin.partial;
+
+	void **entry = (void **)block.free_list;
+	block.free_list = *entry;
+	block.used++;
+	block.mark_used(block.entry_index(entry), true);
+
+	/* remove full block from list of partially used blocks */
+	if (!block.free_list) {
+		bin.partial = block.next;
+		if (block.next)
+			block.next->prev = nullptr;
+		block.next = nullptr;
+	}
+
+	*out_addr = entry;
+	return true;
+}
+
+
+void Heap::_bin_free(Bin_block &block, void *addr)
+{
+	Bin &bin = block.bin;
+
+	size_t const index = block.entry_index(addr);
+
+	if (index == ~0UL || !block.used_entry(index)) {
+		warning("heap could not free memory block");
+		return;
+	}
+
+	block.mark_used(index, false);
+
+	bool const was_full = !block.free_list;
+
+	*(void **)addr  = block.free_list;
+	block.free_list = addr;
+	block.used--;
+
+	/* make block available for allocations */
+	if (was_full) {
+		block.next = bin.partial;
+		if (bin.partial)
+			bin.partial->prev = &block;
+		bin.partial = &block;
+	}
+
+	if (block.used)
+		return;
+
+	/* unlink empty block */
+	if (block.prev) block.prev->next = block.next;
+	else            bin.partial      = block.next;
+	if (block.next) block.next->prev = block.prev;
+	block.prev = block.next = nullptr;
+
+	/* keep one empty block per bin to avoid thrashing */
+	if (!bin.spare)
+		bin.spare = &block;
+	else
+		_release_bin_block(block);
+}
+
+
+void Heap::_release_bin_block(Bin_block &block)
+{
+	_bin_blocks.remove(&block);
+	block.~Bin_block();
+
+	_alloc->free(&block, BIN_BLOCK_SIZE);
+	_quota_used -= BIN_BLOCK_SIZE;
 }
 
 
@@ -225,6 +436,13 @@ bool Heap::alloc(size_t size, void **out_addr)
 	/* serialize access of heap functions */
 	Mutex::Guard guard(_mutex);
 
+	unsigned const bin_index = _bin_index(size);
+
+	if (bin_index < NUM_BINS) {
+
+		return _bin_alloc(_bins[bin_index], out_addr);
+	}
+
 	/* check requested allocation against quota limit */
 	if (size + _quota_used > _quota_limit)
 		return false;
@@ -238,6 +456,13 @@ void Heap::free(void *addr, size_t)
 	/* serialize access of heap functions */
 	Mutex::Guard guard(_mutex);
 
+	if (_bins_enabled) {
+		if (Bin_block *block = _bin_block(addr)) {
+			_bin_free(*block, addr);
+			return;
+		}
+	}
+
 	/* try to find the size in our local allocator */
 	size_t const size = _alloc->size_at(addr);
 
@@ -272,6 +497,18 @@ void Heap::free(void *addr, size_t)
 }
 
 
+size_t Heap::overhead(size_t size) const
+{
+	unsigned const bin_index = _bin_index(size);
+
+	if (bin_index == NUM_BINS)
+		return _alloc->overhead(size);
+
+	/* share of the block occupied by one entry, including the header */
+	return BIN_BLOCK_SIZE / _bin_entries(_bins[bin_index]) - size;
+}
+
+
 Heap::Heap(Ram_allocator *ram_alloc,
            Region_map    *region_map,
            size_t         quota_limit,
@@ -283,6 +520,12 @@ Heap::Heap(Ram_allocator *ram_alloc,
 	_quota_limit(quota_limit), _quota_used(0),
 	_chunk_size(MIN_CHUNK_SIZE)
 {
+	static_assert(sizeof(Bin_block) <= BIN_BLOCK_HEADER,
+	              "bin-block header exceeds its reserved space");
+
+	for (unsigned i = 0; i < NUM_BINS; i++)
+		_bins[i].entry_size = bin_entry_sizes[i];
+
 	if (static_addr)
 		_alloc->add_range((addr_t)static_addr, static_size);
 }
@@ -290,6 +533,14 @@ Heap::Heap(Ram_allocator *ram_alloc,
 
 Heap::~Heap()
 {
+	/*
+	 * Release cached empty bin blocks. Blocks that still contain entries
+	 * are reported as dangling allocations by the AVL allocator.
+	 */
+	for (unsigned i = 0; i < NUM_BINS; i++)
+		if (_bins[i].spare)
+			_release_bin_block(*_bins[i].spare);
+
 	/*
 	 * Revert allocations of heap-internal 'Dataspace' objects. Otherwise, the
 	 * subsequent destruction of the 'Allocator_avl' would detect those blocks
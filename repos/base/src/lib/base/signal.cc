@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <util/retry.h>
+#include <util/hash.h>
 #include <base/env.h>
 #include <base/signal.h>
 #include <base/thread.h>
@@ -146,25 +147,36 @@ namespace Genode {
 		private:
 
 			/*
-			 * Currently, the registry is just a linked list. If this becomes a
-			 * scalability problem, we might introduce a more sophisticated
-			 * associative data structure.
+			 * The contexts are distributed over lists by the hash of their
+			 * address. The registry is consulted for each received signal,
+			 * so its costs must not grow with the number of contexts.
 			 */
+			enum { NUM_LISTS_LOG2 = 8, NUM_LISTS = 1 << NUM_LISTS_LOG2 };
+
 			Mutex mutable                       _mutex { };
-			List<List_element<Signal_context> > _list { };
+			List<List_element<Signal_context> > _lists[NUM_LISTS] { };
+
+			static unsigned _index(Signal_context const *context) {
+				return (unsigned)multiplicative_hash<NUM_LISTS_LOG2>((unsigned long)context); }
+
+			List<List_element<Signal_context> > &_list(Signal_context const *context) {
+				return _lists[_index(context)]; }
+
+			List<List_element<Signal_context> > const &_list(Signal_context const *context) const {
+				return _lists[_index(context)]; }
 
 		public:
 
 			void insert(List_element<Signal_context> *le)
 			{
 				Mutex::Guard guard(_mutex);
-				_list.insert(le);
+				_list(le->object()).insert(le);
 			}
 
 			void remove(List_element<Signal_context> *le)
 			{
 				Mutex::Guard guard(_mutex);
-				_list.remove(le);
+				_list(le->object()).remove(le);
 			}
 
 			bool test_and_lock(Signal_context *context) const
@@ -172,7 +184,7 @@ namespace Genode {
 				Mutex::Guard guard(_mutex);
 
 				/* search list for context */
-				List_element<Signal_context> const *le = _list.first();
+				List_element<Signal_context> const *le = _list(context).first();
 				for ( ; le; le = le->next()) {
 
 					if (context == le->object()) {
@@ -253,21 +265,18 @@ void Signal_receiver::block_for_signal()
 Signal Signal_receiver::pending_signal()
 {
 	Mutex::Guard contexts_guard(_contexts_mutex);
-	Signal::Data result;
-	_contexts.for_each_locked([&] (Signal_context &context) -> bool {
 
-		if (!context._pending) return false;
+	if (Signal_context * const context = _dequeue_ready()) {
+
+		Mutex::Guard context_guard(context->_mutex);
+
+		Signal::Data const result = context->_curr_signal;
+
+		context->_pending     = false;
+		context->_curr_signal = Signal::Data(0, 0);
 
-		_contexts.head(context._next);
-		context._pending     = false;
-		result               = context._curr_signal;
-		context._curr_signal = Signal::Data(0, 0);
+		Trace::Signal_received trace_event(*context, result.num);
 
-		Trace::Signal_received trace_event(context, result.num);
-		return true;
-	});
-	if (result.context) {
-		Mutex::Guard context_guard(result.context->_mutex);
 		if (result.num == 0)
 			warning("returning signal with num == 0");
 
@@ -307,6 +316,7 @@ void Signal_receiver::local_submit(Signal::Data data)
 	/* wake up the receiver if the context becomes pending */
 	if (!context->_pending) {
 		context->_pending = true;
+		_enqueue_ready(*context);
 		_signal_available.up();
 	}
 }
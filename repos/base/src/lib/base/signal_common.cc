@@ -186,6 +186,32 @@ void Signal_receiver::_unsynchronized_dissolve(Signal_context * const context)
 
 	/* remove context from context list */
 	_contexts.remove(context);
+
+	/* drop pending signal that was not picked up yet */
+	Mutex::Guard ready_guard(_ready_mutex);
+	if (context->_ready_fe.enqueued())
+		_ready.remove(context->_ready_fe);
+}
+
+
+void Signal_receiver::_enqueue_ready(Signal_context &context)
+{
+	Mutex::Guard ready_guard(_ready_mutex);
+
+	if (!context._ready_fe.enqueued())
+		_ready.enqueue(context._ready_fe);
+}
+
+
+Signal_context *Signal_receiver::_dequeue_ready()
+{
+	Mutex::Guard ready_guard(_ready_mutex);
+
+	Signal_context *context = nullptr;
+	_ready.dequeue([&] (Fifo_element<Signal_context> &fe) {
+		context = &fe.object(); });
+
+	return context;
 }
 
 
@@ -152,7 +152,10 @@ void Trace::Logger::log(char const *msg, size_t len)
 {
 	if (!this || !_evaluate_control()) return;
 
-	memcpy(buffer->reserve(len), msg, len);
+	char * const dst = buffer->reserve(len);
+	if (!dst) return;
+
+	memcpy(dst, msg, len);
 	buffer->commit(len);
 }
 
@@ -162,7 +165,10 @@ bool Trace::Logger::log_captured(char const *msg, size_t len)
 {
 	if (!this || !_evaluate_control()) return false;
 
-	len = policy_module->log_output(buffer->reserve(len), msg, len);
+	char * const dst = buffer->reserve(len);
+	if (!dst) return false;
+
+	len = policy_module->log_output(dst, msg, len);
 	buffer->commit(len);
 
 	return len != 0;
@@ -29,6 +29,8 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 	_md_alloc(&md_alloc)
 {
 	deps.enqueue(*this);
+	flush_symbol_cache();
+
 	load_needed(env, *_md_alloc, deps, keep);
 }
 
@@ -38,6 +40,8 @@ Linker::Dependency::~Dependency()
 	if (!_unload_on_destruct)
 		return;
 
+	flush_symbol_cache();
+
 	if (!_obj.unload())
 		return;
 
@@ -50,6 +50,9 @@ class Linker::Config : Noncopyable
 		bool const _verbose     = _config.attribute_value("ld_verbose",     false);
 		bool const _check_ctors = _config.attribute_value("ld_check_ctors", true);
 
+		unsigned const _symbol_cache_entries =
+			_config.attribute_value("ld_symbol_cache", 1024U);
+
 	public:
 
 		Config(Env &env) : _config(env) { }
@@ -58,6 +61,12 @@ class Linker::Config : Noncopyable
 		bool verbose()     const { return _verbose; }
 		bool check_ctors() const { return _check_ctors; }
 
+		/**
+		 * Number of entries of the cache of resolved symbols, 0 disables
+		 * the cache
+		 */
+		unsigned symbol_cache_entries() const { return _symbol_cache_entries; }
+
 		typedef String<128> Rom_name;
 
 		/**
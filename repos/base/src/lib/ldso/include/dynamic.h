@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	class  Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,117 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * The symbols of a bucket are stored consecutively in the symbol table. For
+ * each symbol, the chain holds the hash value with the lowest bit marking
+ * the end of the bucket, which avoids most string comparisons. The leading
+ * bloom filter rejects the lookup of most symbols not defined by the object
+ * without touching the buckets at all.
+ */
+struct Linker::Gnu_hash_table
+{
+	Elf::Hashelt const nbuckets;
+	Elf::Hashelt const symoffset;
+	Elf::Hashelt const bloom_size;
+	Elf::Hashelt const bloom_shift;
+
+	Elf::Addr    const *bloom()   const { return (Elf::Addr const *)(this + 1); }
+	Elf::Hashelt const *buckets() const { return (Elf::Hashelt const *)(bloom() + bloom_size); }
+
+	/**
+	 * Return chain entry of symbol, valid for indices from 'symoffset' on
+	 */
+	Elf::Hashelt chain(unsigned long sym_index) const
+	{
+		return (buckets() + nbuckets)[sym_index - symoffset];
+	}
+
+	/**
+	 * Return false if the symbol is definitely not part of the table
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		enum { BITS = sizeof(Elf::Addr)*8 };
+
+		Elf::Addr const word = bloom()[(hash / BITS) & (bloom_size - 1)];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift) % BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of entries of the symbol table
+	 *
+	 * In contrast to the ELF hash table, the GNU hash table does not state
+	 * the number of symbols. It is determined by the end of the chain of
+	 * the bucket with the highest symbol index.
+	 */
+	unsigned long symbol_count() const SELF_RELOC
+	{
+		unsigned long last = 0;
+		for (unsigned i = 0; i < nbuckets; i++)
+			if (buckets()[i] > last)
+				last = buckets()[i];
+
+		if (last < symoffset)
+			return symoffset;
+
+		while (!(chain(last) & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name
+ *
+ * The GNU hash is computed upfront because it is used by the symbol cache.
+ * The ELF hash is computed on demand for objects without GNU hash table.
+ */
+class Linker::Symbol_hash
+{
+	private:
+
+		char const *_name;
+
+		uint32_t const _gnu;
+
+		mutable unsigned long _elf       = 0;
+		mutable bool          _elf_valid = false;
+
+	public:
+
+		Symbol_hash(char const *name)
+		: _name(name), _gnu(Gnu_hash_table::hash(name)) { }
+
+		uint32_t gnu() const { return _gnu; }
+
+		unsigned long elf() const
+		{
+			if (!_elf_valid) {
+				_elf       = Hash_table::hash(_name);
+				_elf_valid = true;
+			}
+			return _elf;
+		}
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,6 +207,8 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+		unsigned long        _symbol_count  = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -169,10 +284,83 @@ class Linker::Dynamic
 				case DT_REL     : _section<typeof(_rel)>(&_rel, d);                     break;
 				case DT_RELSZ   : _rel_size = d->un.val;                                break;
 				case DT_DEBUG   : _section_dt_debug(d);                                 break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
 				default:
 					break;
 				}
 			}
+
+			if (_gnu_hash)
+				_symbol_count = _gnu_hash->symbol_count();
+			else if (_hash_table)
+				_symbol_count = _hash_table->nchains();
+		}
+
+		/**
+		 * Return true if symbol is a definition of the symbol 'name'
+		 */
+		bool _defines(Elf::Sym const &sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym.type() > STT_FUNC)
+				return false;
+
+			if (sym.st_value == 0)
+				return false;
+
+			char const *sym_name = symbol_name(sym);
+
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_gnu_hash(char const *name, uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash;
+
+			if (!h.nbuckets || !h.may_contain(hash))
+				return nullptr;
+
+			unsigned long sym_index = h.buckets()[hash % h.nbuckets];
+
+			/* empty bucket */
+			if (sym_index < h.symoffset)
+				return nullptr;
+
+			for (; sym_index < _symbol_count; sym_index++) {
+
+				Elf::Hashelt const chain = h.chain(sym_index);
+
+				/* compare hash values, ignoring the end-of-chain bit */
+				if ((chain | 1) == (hash | 1) && _defines(_symtab[sym_index], name))
+					return _symtab + sym_index;
+
+				if (chain & 1)
+					break;
+			}
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_hash(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index >= _symbol_count)
+					return nullptr;
+
+				if (_defines(_symtab[sym_index], name))
+					return _symtab + sym_index;
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -216,7 +404,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index >= _symbol_count)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -234,46 +422,28 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
+		 * Use hash table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred over the ELF hash table if both
+		 * are present.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
-
-			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+			if (_gnu_hash)
+				return _lookup_gnu_hash(name, hash.gnu());
 
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_hash(name, hash.elf());
 
 			return nullptr;
 		}
@@ -285,7 +455,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < _symbol_count; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -179,6 +179,8 @@ namespace Linker {
 		DT_PLTREL   = 20,  /* PLT relcation */
 		DT_DEBUG    = 21,  /* debug structure location */
 		DT_JMPREL   = 23,  /* address of PLT relocation */
+
+		DT_GNU_HASH = 0x6ffffef5, /* address of GNU-style hash table */
 	};
 
 
@@ -14,6 +14,10 @@
 #ifndef _INCLUDE__INIT_H_
 #define _INCLUDE__INIT_H_
 
+/* Genode includes */
+#include <trace/timestamp.h>
+
+/* local includes */
 #include <linker.h>
 
 
@@ -82,7 +86,14 @@ struct Linker::Init : List<Object>
 		for (; obj; obj = obj->next_init()) {
 			if (verbose_relocation)
 				log("Relocate ", obj->name());
+
+			Trace::Timestamp const start = verbose ? Trace::timestamp() : 0;
+
 			obj->relocate(bind);
+
+			if (verbose)
+				log("LD: relocated ", obj->name(), " in ",
+				    (Trace::Timestamp)(Trace::timestamp() - start), " cycles");
 		}
 
 		/*
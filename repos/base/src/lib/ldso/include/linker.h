@@ -129,6 +129,13 @@ namespace Linker {
 	 * Global ELF access mutex
 	 */
 	Mutex &mutex();
+
+	/**
+	 * Invalidate the cached results of symbol lookups
+	 *
+	 * Must be called whenever objects or dependencies are added or removed.
+	 */
+	void flush_symbol_cache();
 }
 
 
@@ -0,0 +1,245 @@
+/**
+ * \brief  Cache of resolved symbols
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Large C++ programs refer to the same symbols from many objects and by many
+ * relocations. Without the cache, each of those relocations walks the hash
+ * tables of all objects of the lookup scope. The cache remembers the result
+ * of a lookup keyed by the symbol name and the parameters of the lookup.
+ *
+ * In addition, the cache remembers the most recent lookup of a symbol
+ * referenced by its index in the symbol table of an object. Linkers sort the
+ * relocations of an object by symbol index ('-z combreloc'), so consecutive
+ * relocations often refer to the same symbol. Those relocations are resolved
+ * without hashing the symbol name.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_CACHE_H_
+#define _INCLUDE__SYMBOL_CACHE_H_
+
+/* local includes */
+#include <linker.h>
+
+namespace Linker { class Symbol_cache; }
+
+
+class Linker::Symbol_cache
+{
+	public:
+
+		/**
+		 * Parameters of a symbol lookup
+		 */
+		struct Key
+		{
+			char       const *name;
+			uint32_t          hash;   /* GNU hash of name */
+			Dependency const *scope;  /* first dependency of lookup scope */
+			Dependency const *skip;   /* object skipped by the lookup */
+			bool              undef;
+		};
+
+		/**
+		 * Parameters of a lookup of a symbol referenced by an object
+		 */
+		struct Index_key
+		{
+			Dependency const *dep;
+			unsigned long     index;  /* index in symbol table of 'dep' */
+			bool              undef;
+			bool              other;
+		};
+
+		struct Result
+		{
+			Elf::Sym const *sym;
+			Elf::Addr       base;
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Symbol_cache(Symbol_cache const &);
+		Symbol_cache &operator = (Symbol_cache const &);
+
+		struct Entry
+		{
+			Key    key;
+			Result result;
+		};
+
+		/*
+		 * Lookups of lazily bound jump slots may happen concurrently to the
+		 * loading of shared objects.
+		 */
+		Mutex _mutex { };
+
+		Allocator &_alloc;
+
+		unsigned const _num_entries;
+
+		Entry * const _entries;
+
+		Index_key _last_key    { };
+		Result    _last_result { };
+
+		unsigned long _hits       = 0;
+		unsigned long _misses     = 0;
+		unsigned long _index_hits = 0;
+
+		/* incremented on each flush */
+		unsigned long _generation = 0;
+
+		static unsigned _power_of_two(unsigned n)
+		{
+			unsigned result = 1;
+			while (result*2 <= n)
+				result *= 2;
+			return result;
+		}
+
+		Entry &_entry(Key const &key)
+		{
+			addr_t const scope = (addr_t)key.scope >> 4;
+
+			return _entries[(key.hash ^ scope) & (_num_entries - 1)];
+		}
+
+		static bool _matches(Key const &a, Key const &b)
+		{
+			return a.hash  == b.hash
+			    && a.scope == b.scope
+			    && a.skip  == b.skip
+			    && a.undef == b.undef
+			    && (a.name == b.name || !strcmp(a.name, b.name));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_entries  number of cache entries, rounded down to a
+		 *                     power of two
+		 */
+		Symbol_cache(Allocator &alloc, unsigned num_entries)
+		:
+			_alloc(alloc), _num_entries(_power_of_two(num_entries)),
+			_entries((Entry *)alloc.alloc(_num_entries*sizeof(Entry)))
+		{
+			flush();
+		}
+
+		~Symbol_cache() { _alloc.free(_entries, _num_entries*sizeof(Entry)); }
+
+		/**
+		 * Look up cached result
+		 *
+		 * \param generation  returned generation of the cache, to be passed
+		 *                    to 'insert' on a cache miss
+		 *
+		 * \return true if 'result' was set from a cache entry
+		 */
+		bool lookup(Key const &key, Result &result, unsigned long &generation)
+		{
+			Mutex::Guard guard(_mutex);
+
+			generation = _generation;
+
+			Entry const &e = _entry(key);
+
+			if (!e.result.sym || !_matches(e.key, key)) {
+				_misses++;
+				return false;
+			}
+
+			_hits++;
+			result = e.result;
+			return true;
+		}
+
+		/**
+		 * Insert result of lookup
+		 *
+		 * The result is dropped if the cache was flushed since the
+		 * 'generation' was obtained via 'lookup'.
+		 */
+		void insert(Key const &key, Result const &result, unsigned long generation)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (generation == _generation)
+				_entry(key) = Entry { key, result };
+		}
+
+		/**
+		 * Look up result of the most recent lookup by symbol index
+		 *
+		 * \param generation  returned generation of the cache, to be passed
+		 *                    to 'insert' on a cache miss
+		 *
+		 * \return true if 'result' was set
+		 */
+		bool lookup(Index_key const &key, Result &result, unsigned long &generation)
+		{
+			Mutex::Guard guard(_mutex);
+
+			generation = _generation;
+
+			if (!_last_result.sym
+			 || _last_key.dep   != key.dep   || _last_key.index != key.index
+			 || _last_key.undef != key.undef || _last_key.other != key.other)
+				return false;
+
+			_index_hits++;
+			result = _last_result;
+			return true;
+		}
+
+		void insert(Index_key const &key, Result const &result, unsigned long generation)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (generation == _generation) {
+				_last_key    = key;
+				_last_result = result;
+			}
+		}
+
+		/**
+		 * Invalidate all entries
+		 *
+		 * The cache must be flushed whenever an object is loaded or unloaded
+		 * because this may change the result of lookups, and cached names
+		 * refer to the string tables of the objects.
+		 */
+		void flush()
+		{
+			Mutex::Guard guard(_mutex);
+
+			_generation++;
+			memset(_entries, 0, _num_entries*sizeof(Entry));
+
+			_last_result = Result { };
+		}
+
+		unsigned long hits()   const { return _hits; }
+		unsigned long misses() const { return _misses; }
+
+		/**
+		 * Number of lookups resolved by the most recent lookup by index
+		 */
+		unsigned long index_hits() const { return _index_hits; }
+};
+
+#endif /* _INCLUDE__SYMBOL_CACHE_H_ */
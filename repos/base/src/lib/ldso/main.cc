@@ -30,6 +30,7 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <symbol_cache.h>
 
 using namespace Linker;
 
@@ -69,6 +70,19 @@ Genode::Mutex &Linker::mutex()
 }
 
 
+static Genode::Constructible<Symbol_cache> &symbol_cache()
+{
+	return *unmanaged_singleton<Constructible<Symbol_cache>>();
+}
+
+
+void Linker::flush_symbol_cache()
+{
+	if (symbol_cache().constructed())
+		symbol_cache()->flush();
+}
+
+
 /**************************************************************
  ** ELF object types (shared object, dynamic binaries, ldso  **
  **************************************************************/
@@ -129,6 +143,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			/* register for static construction and relocation */
 			Init::list()->insert(this);
 			obj_list()->enqueue(*this);
+			flush_symbol_cache();
 
 			/* add to link map */
 			Debug::state_change(Debug::ADD, nullptr);
@@ -152,6 +167,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			/* remove from loaded objects list */
 			obj_list()->remove(*this);
 			Init::list()->remove(this);
+			flush_symbol_cache();
 		}
 
 		/**
@@ -173,7 +189,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -513,8 +529,7 @@ void genode_exit(int status)
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
-	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
+	Elf::Sym const *sym = dynamic().lookup_symbol(name, Symbol_hash(name));
 
 	if (sym)
 		return reloc_base() + sym->st_value;
@@ -579,15 +594,38 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 		return symbol;
 	}
 
-	return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
+	char const * const name = elf.symbol_name(*symbol);
+
+	if (!dep.root() || !symbol_cache().constructed())
+		return lookup_symbol(name, dep, base, undef, other);
+
+	Symbol_cache::Index_key const key { .dep   = &dep,
+	                                    .index = sym_index,
+	                                    .undef = undef,
+	                                    .other = other };
+
+	Symbol_cache::Result result     { };
+	unsigned long        generation = 0;
+
+	if (symbol_cache()->lookup(key, result, generation)) {
+		*base = result.base;
+		return result.sym;
+	}
+
+	Elf::Sym const *sym = lookup_symbol(name, dep, base, undef, other);
+
+	symbol_cache()->insert(key, Symbol_cache::Result { sym, *base }, generation);
+	return sym;
 }
 
 
-Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
+static Elf::Sym const *lookup_symbol_in_scope(char const *name,
+                                              Symbol_hash const &hash,
+                                              Dependency const &dep,
+                                              Elf::Addr *base,
+                                              bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -625,7 +663,8 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	/* try searching binary's dependencies */
 	if (!weak_symbol && dep.root()) {
 		if (binary_ptr && &dep != binary_ptr->first_dep()) {
-			return lookup_symbol(name, *binary_ptr->first_dep(), base, undef, other);
+			return lookup_symbol_in_scope(name, hash, *binary_ptr->first_dep(),
+			                              base, undef, other);
 		} else {
 			throw Not_found(name);
 		}
@@ -642,6 +681,39 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 }
 
 
+Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	Symbol_hash const hash(name);
+
+	/*
+	 * The cache is not used during the self relocation of the linker, which
+	 * is the only case of a dependency without root.
+	 */
+	if (!dep.root() || !symbol_cache().constructed())
+		return lookup_symbol_in_scope(name, hash, dep, base, undef, other);
+
+	Symbol_cache::Key const key { .name  = name,
+	                              .hash  = hash.gnu(),
+	                              .scope = &dep.first(),
+	                              .skip  = other ? &dep : nullptr,
+	                              .undef = undef };
+
+	Symbol_cache::Result result     { };
+	unsigned long        generation = 0;
+
+	if (symbol_cache()->lookup(key, result, generation)) {
+		*base = result.base;
+		return result.sym;
+	}
+
+	Elf::Sym const *sym = lookup_symbol_in_scope(name, hash, dep, base, undef, other);
+
+	symbol_cache()->insert(key, Symbol_cache::Result { sym, *base }, generation);
+	return sym;
+}
+
+
 /********************
  ** Initialization **
  ********************/
@@ -804,6 +876,9 @@ void Component::construct(Genode::Env &env)
 
 	parent_ptr = &env.parent();
 
+	if (config.symbol_cache_entries())
+		symbol_cache().construct(*heap(), config.symbol_cache_entries());
+
 	/* load binary and all dependencies */
 	try {
 		binary_ptr = unmanaged_singleton<Binary>(env, *heap(), config, binary_name());
@@ -825,6 +900,11 @@ void Component::construct(Genode::Env &env)
 			    ": stack area");
 			Elf_object::obj_list()->for_each([] (Object const &obj) {
 				dump_link_map(obj); });
+
+			if (symbol_cache().constructed())
+				log("LD: symbol cache: ", symbol_cache()->hits(), " hits, ",
+				    symbol_cache()->misses(), " misses, ",
+				    symbol_cache()->index_hits(), " repeated references");
 		}
 	} catch (...) {  }
 
@@ -86,17 +86,17 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 		/*
 		 * Filter out all pending timeouts to a local list first. The
 		 * processing of pending timeouts can have effects on the '_timeouts'
-		 * list and these would interfere with the filtering if we would do
+		 * tree and these would interfere with the filtering if we would do
 		 * it all in the same loop.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
+		while (Timeout *timeout = _first_timeout()) {
 
 			timeout->_mutex.acquire();
 			if (timeout->_deadline.value > _current_time.value) {
 				timeout->_mutex.release();
 				break;
 			}
-			_timeouts.remove(timeout);
+			_remove_from_timeouts(*timeout);
 			pending_timeouts.insert(&timeout->_pending_timeouts_le);
 		}
 		/*
@@ -153,9 +153,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timeouts tree */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_insert_into_timeouts(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -223,7 +223,7 @@ Timeout_scheduler::~Timeout_scheduler()
 	_destructor_called = true;
 
 	/* discard all scheduled timeouts */
-	while (Timeout *timeout = _timeouts.first()) {
+	while (Timeout *timeout = _first_timeout()) {
 		Mutex::Guard const timeout_guard { timeout->_mutex };
 		_discard_timeout_unsynchronized(*timeout);
 	}
@@ -242,9 +242,10 @@ void Timeout_scheduler::_enable()
 
 void Timeout_scheduler::_set_time_source_timeout()
 {
+	Timeout const *first_timeout { _first_timeout() };
 	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
+		first_timeout ?
+			first_timeout->_deadline.value - _current_time.value :
 			~(uint64_t)0);
 }
 
@@ -295,9 +296,8 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 	Mutex::Guard const timeout_guard(timeout._mutex);
 
 	/* prevent inserting a timeout twice */
-	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
-	}
+	_remove_from_timeouts(timeout);
+
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
 		_time_source.curr_time().trunc_to_plain_us().value };
@@ -306,42 +306,50 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/* set up timeout object and insert into timeouts tree */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_insert_into_timeouts(timeout);
 
 	/*
 	 * If the new timeout is the first to trigger, we have to  update the
 	 * time-source timeout.
 	 */
-	if (_timeouts.first() == &timeout) {
+	if (_first_timeout() == &timeout) {
 		_set_time_source_timeout(deadline_us - curr_time_us);
 	}
 }
 
 
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
+void Timeout_scheduler::_insert_into_timeouts(Timeout &timeout)
 {
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
+	_timeouts.insert(&timeout);
+	timeout._in_timeouts = true;
+}
+
+
+void Timeout_scheduler::_remove_from_timeouts(Timeout &timeout)
+{
+	if (!timeout._in_timeouts) {
 		return;
 	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
-		return;
+	_timeouts.remove(&timeout);
+	timeout._in_timeouts = false;
+}
+
+
+Timeout *Timeout_scheduler::_first_timeout() const
+{
+	/* the timeout with the earliest deadline is the leftmost node */
+	Timeout *timeout { _timeouts.first() };
+	if (timeout == nullptr) {
+		return nullptr;
+	}
+	while (Timeout *left = timeout->child(Timeout::LEFT)) {
+		timeout = left;
 	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
+	return timeout;
 }
 
 
@@ -392,7 +400,7 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	_remove_from_timeouts(timeout);
 	timeout._handler = nullptr;
 }
 
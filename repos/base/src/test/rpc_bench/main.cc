@@ -0,0 +1,181 @@
+/*
+ * \brief  Benchmark of RPC round trips to entrypoints with many objects
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The server entrypoint manages a growing number of RPC objects, like a
+ * server with many sessions. For each population, the benchmark measures
+ * the rate of round trips to the same object and to randomly chosen
+ * objects, which both include the lookup of the invoked object in the
+ * entrypoint's object pool. Each call must reach the invoked object, and
+ * the rate of calls to random objects of the largest population must not
+ * drop below 'min_scaling_pc' percent of the rate with a single object.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Timer::Stopwatch;
+
+	struct Session;
+	struct Session_component;
+	struct Main;
+}
+
+
+struct Test::Session : Interface
+{
+	GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_ping);
+};
+
+
+struct Test::Session_component : Rpc_object<Session, Session_component>
+{
+	unsigned const _id;
+
+	Session_component(unsigned id) : _id(id) { }
+
+	unsigned ping(unsigned value) { return value + _id; }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Stopwatch _stopwatch { _timer };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Entrypoint _server_ep { _env, 4*1024*sizeof(addr_t), "server_ep",
+	                        Affinity::Location() };
+
+	unsigned const _max_objects = _config.xml().attribute_value("max_objects", 4096U);
+	unsigned const _calls       = _config.xml().attribute_value("calls", 100000U);
+
+	unsigned const _min_scaling_pc =
+		_config.xml().attribute_value("min_scaling_pc", 0U);
+
+	Session_component  ** const _objects =
+		new (_heap) Session_component *[_max_objects];
+
+	Capability<Session> * const _caps =
+		new (_heap) Capability<Session>[_max_objects];
+
+	unsigned _num_objects = 0;
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/* rate of calls to random objects for a single object */
+	uint64_t _base_rate = 0;
+
+	void _populate(unsigned num_objects)
+	{
+		for (; _num_objects < num_objects; _num_objects++) {
+			_objects[_num_objects] = new (_heap) Session_component(_num_objects);
+			_caps[_num_objects] = _server_ep.manage(*_objects[_num_objects]);
+		}
+	}
+
+	bool _call(unsigned i, unsigned value)
+	{
+		if (_caps[i].call<Session::Rpc_ping>(value) == value + i)
+			return true;
+
+		error("RPC to object ", i, " reached a different object");
+		return false;
+	}
+
+	bool _bench(unsigned num_objects)
+	{
+		_populate(num_objects);
+
+		bool ok = true;
+
+		uint64_t const same_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _calls && ok; i++)
+				ok = _call(0, i); });
+
+		uint64_t const random_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _calls && ok; i++)
+				ok = _call(_random() % _num_objects, i); });
+
+		if (!ok)
+			return false;
+
+		uint64_t const random_rate = Stopwatch::rate(_calls, random_us);
+
+		log(num_objects, " objects: ",
+		    "same object ",    Stopwatch::rate(_calls, same_us), " calls/s, ",
+		    "random objects ", random_rate,                      " calls/s");
+
+		if (num_objects == 1)
+			_base_rate = random_rate;
+
+		if (random_rate*100 < _base_rate*_min_scaling_pc) {
+			error("rate with ", num_objects, " objects below ",
+			      _min_scaling_pc, "% of the rate with a single object");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool _run()
+	{
+		bool ok = true;
+		for (unsigned n = 1; n <= _max_objects && ok; n *= 4)
+			ok = _bench(n);
+
+		for (unsigned i = 0; i < _num_objects; i++) {
+			_server_ep.dissolve(*_objects[i]);
+			destroy(_heap, _objects[i]);
+		}
+
+		return ok;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_env.parent().exit(_run() ? 0 : -1);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
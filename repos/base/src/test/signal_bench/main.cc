@@ -0,0 +1,152 @@
+/*
+ * \brief  Benchmark of the signal delivery with many signal handlers
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The entrypoint of the component manages a growing number of signal
+ * handlers, like a server with many sessions. Only the most recently
+ * created handler is active. It submits a signal to itself whenever it is
+ * called so that the benchmark measures the latency of the delivery of one
+ * signal depending on the number of handlers. Signals must never reach an
+ * inactive handler, and the rate for the largest number of handlers must not
+ * drop below 'min_scaling_pc' percent of the rate for a single handler.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Timer::Stopwatch;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Stopwatch _stopwatch { _timer };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	unsigned const _max_handlers =
+		_config.xml().attribute_value("max_handlers", 4096U);
+
+	unsigned const _signals =
+		max(1U, _config.xml().attribute_value("signals", 10000U));
+
+	unsigned const _min_scaling_pc =
+		_config.xml().attribute_value("min_scaling_pc", 0U);
+
+	struct Handler
+	{
+		Main &_main;
+
+		Signal_handler<Handler> sigh;
+
+		void _handle() { _main._handle_signal(*this); }
+
+		Handler(Main &main)
+		: _main(main), sigh(main._env.ep(), *this, &Handler::_handle) { }
+	};
+
+	Handler ** const _handlers = new (_heap) Handler *[_max_handlers];
+
+	unsigned _num_handlers = 0;
+	unsigned _population   = 1;
+	unsigned _received     = 0;
+	uint64_t _base_rate    = 0;
+
+	Handler &_active() { return *_handlers[_num_handlers - 1]; }
+
+	void _submit() { Signal_transmitter(_active().sigh).submit(); }
+
+	void _start_round()
+	{
+		while (_num_handlers < _population)
+			_handlers[_num_handlers++] = new (_heap) Handler(*this);
+
+		_received = 0;
+		_stopwatch.restart();
+		_submit();
+	}
+
+	void _exit(int code) { _env.parent().exit(code); }
+
+	void _handle_signal(Handler &handler)
+	{
+		if (&handler != &_active()) {
+			error("signal reached an inactive handler");
+			_exit(-1);
+			return;
+		}
+
+		if (++_received < _signals) {
+			_submit();
+			return;
+		}
+
+		uint64_t const us   = _stopwatch.elapsed_us();
+		uint64_t const rate = Stopwatch::rate(_signals, us);
+
+		log(_population, " handlers: ",
+		    rate, " signals/s, ",
+		    us*1000/_signals, " ns per signal");
+
+		if (_population == 1)
+			_base_rate = rate;
+
+		if (rate*100 < _base_rate*_min_scaling_pc) {
+			error("rate with ", _population, " handlers below ",
+			      _min_scaling_pc, "% of the rate with a single handler");
+			_exit(-1);
+			return;
+		}
+
+		if (_population*4 > _max_handlers) {
+			_exit(0);
+			return;
+		}
+
+		_population *= 4;
+		_start_round();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		if (_max_handlers)
+			_start_round();
+		else
+			_exit(0);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-signal_bench
+SRC_CC = main.cc
+LIBS   = base
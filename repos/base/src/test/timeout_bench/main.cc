@@ -0,0 +1,195 @@
+/*
+ * \brief  Benchmark of the timeout scheduler with many live timeouts
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The scheduler is driven by a simulated time source, which lets the
+ * benchmark measure the costs of scheduling, discarding, and firing timeouts
+ * independent of the resolution of the actual timer. The test fails if a
+ * discarded timeout fires or if the scheduling rate with the largest number
+ * of timeouts drops below 'min_scaling_pc' percent of the rate with the
+ * smallest number.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Timer::Stopwatch;
+
+	struct Simulated_time_source;
+	struct Bench_timeout;
+	struct Main;
+}
+
+
+struct Test::Simulated_time_source : Time_source
+{
+	uint64_t         now_us  { 0 };
+	Timeout_handler *handler { nullptr };
+
+	Duration curr_time() override { return Duration(Microseconds(now_us)); }
+
+	Microseconds max_timeout() const override { return Microseconds(~0ULL); }
+
+	void set_timeout(Microseconds, Timeout_handler &h) override { handler = &h; }
+
+	/**
+	 * Advance time and let the scheduler handle the timeouts that are due
+	 */
+	void advance(uint64_t us)
+	{
+		now_us += us;
+		if (handler)
+			handler->handle_timeout(curr_time());
+	}
+};
+
+
+struct Test::Bench_timeout : Timeout_handler
+{
+	Timeout   timeout;
+	unsigned &fired;
+
+	Bench_timeout(Timeout_scheduler &scheduler, unsigned &fired)
+	: timeout(scheduler), fired(fired) { }
+
+	void handle_timeout(Duration) override { fired++; }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Stopwatch _stopwatch { _timer };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	struct Result { bool ok; uint64_t schedule_rate; };
+
+	Result _bench(unsigned const count)
+	{
+		enum { MAX_DURATION_US = 1000*1000 };
+
+		Simulated_time_source time_source { };
+
+		Timeout_scheduler scheduler { time_source, Microseconds(0) };
+
+		unsigned fired = 0;
+
+		Bench_timeout **timeouts = (Bench_timeout **)
+			static_cast<Allocator &>(_heap).alloc(count*sizeof(Bench_timeout *));
+
+		for (unsigned i = 0; i < count; i++)
+			timeouts[i] = new (_heap) Bench_timeout(scheduler, fired);
+
+		/* arm all timeouts with random deadlines */
+		uint64_t const schedule_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < count; i++)
+				timeouts[i]->timeout.schedule_one_shot(
+					Microseconds(1 + _random() % MAX_DURATION_US), *timeouts[i]);
+		});
+
+		/* re-arm live timeouts, e.g., retransmission timers on ACK */
+		uint64_t const reschedule_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < count; i++) {
+				Bench_timeout &t = *timeouts[_random() % count];
+				t.timeout.schedule_one_shot(
+					Microseconds(1 + _random() % MAX_DURATION_US), t);
+			}
+		});
+
+		/* discard every other timeout */
+		uint64_t const discard_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < count; i += 2)
+				timeouts[i]->timeout.discard();
+		});
+
+		/* let time pass until all remaining timeouts fired */
+		uint64_t const fire_us = _stopwatch.measure_us([&] {
+			while (fired < count/2)
+				time_source.advance(MAX_DURATION_US/1000);
+		});
+
+		/* discarded timeouts must never fire */
+		time_source.advance(MAX_DURATION_US);
+		bool const ok = (fired == count/2);
+		if (!ok)
+			error(count, " timeouts: ", fired, " fired instead of ", count/2);
+
+		log(count, " timeouts: ",
+		    "schedule ",   Stopwatch::rate(count,   schedule_us),   " ops/s, ",
+		    "reschedule ", Stopwatch::rate(count,   reschedule_us), " ops/s, ",
+		    "discard ",    Stopwatch::rate(count/2, discard_us),    " ops/s, ",
+		    "fire ",       Stopwatch::rate(count/2, fire_us),       " ops/s");
+
+		for (unsigned i = 0; i < count; i++)
+			destroy(_heap, timeouts[i]);
+
+		_heap.free(timeouts, count*sizeof(Bench_timeout *));
+
+		return { ok, Stopwatch::rate(count, schedule_us) };
+	}
+
+	bool _run()
+	{
+		Xml_node const config = _config.xml();
+
+		unsigned const max_count   = config.attribute_value("max_timeouts", 100000U);
+		unsigned const min_scaling = config.attribute_value("min_scaling_pc", 10U);
+
+		uint64_t first_rate = 0, last_rate = 0;
+		for (unsigned count = 1000; count <= max_count; count *= 10) {
+
+			Result const result = _bench(count);
+			if (!result.ok)
+				return false;
+
+			if (!first_rate)
+				first_rate = result.schedule_rate;
+			last_rate = result.schedule_rate;
+		}
+
+		if (last_rate*100 < first_rate*min_scaling) {
+			error("schedule rate dropped from ", first_rate, " to ",
+			      last_rate, " ops/s");
+			return false;
+		}
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_env.parent().exit(_run() ? 0 : -1);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,198 @@
+/*
+ * \brief  Benchmark of traversing large XML documents with and without index
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark generates an init-like configuration with many start nodes
+ * and mimics the work of a config reload, which looks up the routing and
+ * resource information of each start node. The indexed variant includes the
+ * costs of creating the index for each reload.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Timer::Stopwatch _stopwatch { _timer };
+
+	enum { BUFFER_SIZE = 8*1024*1024 };
+
+	Attached_ram_dataspace _buffer_ds { _env.ram(), _env.rm(), BUFFER_SIZE };
+
+	char *_buffer() { return _buffer_ds.local_addr<char>(); }
+
+	size_t _generate(unsigned num_starts)
+	{
+		Xml_generator xml(_buffer(), BUFFER_SIZE, "config", [&] () {
+
+			xml.node("parent-provides", [&] () {
+				static char const *services[] = { "ROM", "PD", "CPU", "LOG" };
+				for (char const *service : services)
+					xml.node("service", [&] () {
+						xml.attribute("name", service); }); });
+
+			for (unsigned i = 0; i < num_starts; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<32>("child-", i));
+					xml.attribute("caps", 100);
+
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", "4M"); });
+
+					xml.node("config", [&] () {
+						for (unsigned j = 0; j < 8; j++)
+							xml.node("option", [&] () {
+								xml.attribute("value", j); }); });
+
+					xml.node("route", [&] () {
+						xml.node("service", [&] () {
+							xml.attribute("name", "ROM");
+							xml.node("parent"); });
+						xml.node("any-service", [&] () {
+							xml.node("parent"); }); });
+				});
+			}
+		});
+		return strlen(_buffer());
+	}
+
+	/**
+	 * Evaluate the configuration like a config reload of init
+	 *
+	 * \return checksum of the visited information
+	 */
+	static unsigned long _evaluate(Xml_node const &config)
+	{
+		unsigned long sum = 0;
+
+		config.for_each_sub_node("start", [&] (Xml_node const &start) {
+
+			sum += start.attribute_value("caps", 0UL);
+
+			start.with_sub_node("resource", [&] (Xml_node const &resource) {
+				sum += resource.attribute_value("quantum", Number_of_bytes()); });
+
+			if (start.has_sub_node("route"))
+				start.sub_node("route").for_each_sub_node([&] (Xml_node const &) {
+					sum++; });
+
+			sum += start.sub_node("config").num_sub_nodes();
+		});
+
+		return sum;
+	}
+
+	/**
+	 * Return average duration of 'rounds' calls of 'fn'
+	 */
+	template <typename FN>
+	uint64_t _measure_us(unsigned rounds, FN const &fn)
+	{
+		return _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < rounds; i++)
+				fn(); })/rounds;
+	}
+
+	/*
+	 * Each start node consists of the start, resource, config, route,
+	 * service, any-service, two parent, and eight option nodes. Further
+	 * nodes are the config node and the parent-provides node with four
+	 * service nodes.
+	 */
+	static unsigned _expected_nodes(unsigned num_starts) {
+		return 6 + 16*num_starts; }
+
+	static unsigned long _expected_sum(unsigned num_starts) {
+		return num_starts*(100UL + 4*1024*1024 + 2 + 8); }
+
+	bool _bench(unsigned num_starts, unsigned rounds)
+	{
+		size_t const len = _generate(num_starts);
+
+		unsigned long plain_sum = 0, indexed_sum = 0;
+		unsigned num_nodes = 0;
+
+		uint64_t const plain_us = _measure_us(rounds, [&] {
+			plain_sum = _evaluate(Xml_node(_buffer(), len)); });
+
+		uint64_t const index_us = _measure_us(rounds, [&] {
+			Xml_index index(_heap, _buffer(), len);
+			num_nodes = index.num_nodes(); });
+
+		uint64_t const indexed_us = _measure_us(rounds, [&] {
+			Xml_index index(_heap, _buffer(), len);
+			indexed_sum = _evaluate(index.xml()); });
+
+		if (plain_sum != _expected_sum(num_starts) || indexed_sum != plain_sum) {
+			error(num_starts, " starts: checksum plain ", plain_sum, ", indexed ",
+			      indexed_sum, ", expected ", _expected_sum(num_starts));
+			return false;
+		}
+
+		if (num_nodes != _expected_nodes(num_starts)) {
+			error(num_starts, " starts: index holds ", num_nodes,
+			      " nodes, expected ", _expected_nodes(num_starts));
+			return false;
+		}
+
+		log(num_starts, " starts (", len/1024, " KiB, ", num_nodes, " nodes): ",
+		    "plain ", plain_us, " us, ",
+		    "indexed ", indexed_us, " us ",
+		    "(index creation ", index_us, " us)");
+
+		return true;
+	}
+
+	bool _run()
+	{
+		unsigned const max_starts =
+			_config.xml().attribute_value("max_starts", 1000U);
+
+		for (unsigned num_starts = 10; num_starts <= max_starts; num_starts *= 10)
+			if (!_bench(num_starts, 10))
+				return false;
+
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_env.parent().exit(_run() ? 0 : -1);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
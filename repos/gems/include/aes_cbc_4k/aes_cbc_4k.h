@@ -26,6 +26,29 @@ namespace Aes_cbc_4k {
 
 	void encrypt(Key const &, Block_number, Plaintext  const &, Ciphertext &);
 	void decrypt(Key const &, Block_number, Ciphertext const &, Plaintext  &);
+
+	/**
+	 * Encrypt 'count' blocks with consecutive block numbers
+	 *
+	 * The blocks are numbered starting at 'first'. Processing many blocks
+	 * at once amortizes the lookup of the key schedule.
+	 */
+	void encrypt(Key const &, Block_number first, Plaintext const *,
+	             Ciphertext *, unsigned count);
+
+	/**
+	 * Decrypt 'count' blocks with consecutive block numbers
+	 */
+	void decrypt(Key const &, Block_number first, Ciphertext const *,
+	             Plaintext *, unsigned count);
+
+	/**
+	 * Wipe the cached key schedule of a key that is no longer used
+	 *
+	 * The expanded key schedules of recently used keys are cached to avoid
+	 * the key expansion and the derivation of the ESSIV key for each block.
+	 */
+	void forget(Key const &);
 }
 
 #endif /* _AES_CBC_4K_H_ */
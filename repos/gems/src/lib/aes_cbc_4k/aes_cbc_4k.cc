@@ -12,11 +12,13 @@
  */
 
 #include <base/log.h>
+#include <base/mutex.h>
 #include <util/string.h>
 
 #include <aes_cbc_4k/aes_cbc_4k.h>
 
-#include <openssl/aes.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 
 namespace Aes_cbc
@@ -36,6 +38,10 @@ namespace Aes_cbc
 	struct Hash {
 		unsigned char values[SHA256_DIGEST_LENGTH];
 	};
+
+	class Key_schedule;
+
+	enum { MAX_CACHED_KEYS = 4 };
 };
 
 static bool hash_key(Aes_cbc_4k::Key const &key, Aes_cbc::Hash &hash)
@@ -77,90 +83,284 @@ static void inline cleanup_crypto_data(T &t, S &s)
 }
 
 /**
- * Calculate initialization vector (IV) according to
- * "Encrypted salt-sector initialization vector" (ESSIV) algorithm
- * by Clemens Fruhwirth (July 18, 2005) published in
- * "New Methods in Hard Disk Encryption" paper.
+ * Expanded key state of one key
+ *
+ * The cipher contexts hold the expanded AES key for the encryption and the
+ * decryption of data blocks, and the key for calculating the initialization
+ * vector (IV) according to the "Encrypted salt-sector initialization vector"
+ * (ESSIV) algorithm by Clemens Fruhwirth (July 18, 2005) published in
+ * "New Methods in Hard Disk Encryption" paper. The ESSIV key is the SHA-256
+ * hash of the key. Using the EVP interface lets libcrypto pick hardware
+ * acceleration when available.
  */
-static bool calculate_iv(Aes_cbc_4k::Key          const &key,
-                         Aes_cbc_4k::Block_number const &block,
-                         Aes_cbc::Iv                    &cipher_iv)
+class Aes_cbc::Key_schedule
 {
-	Aes_cbc::Hash hash_of_key;
-	if (!hash_key(key, hash_of_key))
-		return false;
+	private:
 
-	AES_KEY key_for_iv;
-	if (AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
-	                        &key_for_iv)) {
-		/* clean up crypto relevant data which stays otherwise on stack */
-		cleanup_crypto_data(hash_of_key);
-		return false;
-	}
+		/*
+		 * Noncopyable
+		 */
+		Key_schedule(Key_schedule const &);
+		Key_schedule &operator = (Key_schedule const &);
 
-	Aes_cbc::Sn const plain  { block };
-	Aes_cbc::Iv       ivec   { };       /* zero IV */
+		Aes_cbc_4k::Key _key { };
 
-	static_assert(sizeof(plain.values) == sizeof(cipher_iv.values),
-	              "-plain- size vs -iv- size mismatch");
+		EVP_CIPHER_CTX *_encrypt = nullptr;
+		EVP_CIPHER_CTX *_decrypt = nullptr;
+		EVP_CIPHER_CTX *_essiv   = nullptr;
 
-	AES_cbc_encrypt(plain.values, cipher_iv.values, sizeof(plain.values),
-	                &key_for_iv, ivec.values, AES_ENCRYPT);
+		/**
+		 * Calculate IV of block
+		 */
+		bool _iv(Aes_cbc_4k::Block_number const &block, Iv &iv)
+		{
+			Sn const plain { block };
 
-	cleanup_crypto_data(hash_of_key, key_for_iv);
+			static_assert(sizeof(plain.values) == sizeof(iv.values),
+			              "-plain- size vs -iv- size mismatch");
 
-	return true;
-}
+			/* CBC encryption of a single block with zero IV equals ECB */
+			int len = 0;
+			return EVP_EncryptUpdate(_essiv, iv.values, &len, plain.values,
+			                         sizeof(plain.values))
+			    && len == sizeof(iv.values);
+		}
 
-void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
-                         Plaintext const &plain, Ciphertext &cipher)
+	public:
+
+		/* age for the replacement of the least recently used schedule */
+		unsigned long last_use = 0;
+
+		Key_schedule() { }
+
+		~Key_schedule() { wipe(); }
+
+		bool valid() const { return _encrypt != nullptr; }
+
+		bool matches(Aes_cbc_4k::Key const &key) const
+		{
+			return valid()
+			    && !CRYPTO_memcmp(_key.values, key.values, sizeof(key.values));
+		}
+
+		/**
+		 * Expand key
+		 *
+		 * \return false on error, in which case the schedule stays invalid
+		 */
+		bool init(Aes_cbc_4k::Key const &key)
+		{
+			wipe();
+
+			unsigned char const *key_values =
+				reinterpret_cast<unsigned char const *>(key.values);
+
+			Hash hash_of_key;
+			if (!hash_key(key, hash_of_key))
+				return false;
+
+			_encrypt = EVP_CIPHER_CTX_new();
+			_decrypt = EVP_CIPHER_CTX_new();
+			_essiv   = EVP_CIPHER_CTX_new();
+
+			bool const ok =
+			    _encrypt && _decrypt && _essiv
+			 && EVP_EncryptInit_ex(_encrypt, EVP_aes_256_cbc(), nullptr, key_values, nullptr)
+			 && EVP_DecryptInit_ex(_decrypt, EVP_aes_256_cbc(), nullptr, key_values, nullptr)
+			 && EVP_EncryptInit_ex(_essiv, EVP_aes_256_ecb(), nullptr, hash_of_key.values, nullptr)
+			 && EVP_CIPHER_CTX_set_padding(_encrypt, 0)
+			 && EVP_CIPHER_CTX_set_padding(_decrypt, 0)
+			 && EVP_CIPHER_CTX_set_padding(_essiv, 0);
+
+			/* clean up crypto relevant data which stays otherwise on stack */
+			cleanup_crypto_data(hash_of_key);
+
+			if (!ok) {
+				wipe();
+				return false;
+			}
+
+			Genode::memcpy(_key.values, key.values, sizeof(_key.values));
+			return true;
+		}
+
+		/**
+		 * Release contexts, which wipes the expanded keys
+		 */
+		void wipe()
+		{
+			if (_encrypt) EVP_CIPHER_CTX_free(_encrypt);
+			if (_decrypt) EVP_CIPHER_CTX_free(_decrypt);
+			if (_essiv)   EVP_CIPHER_CTX_free(_essiv);
+
+			_encrypt = _decrypt = _essiv = nullptr;
+
+			cleanup_crypto_data(_key);
+		}
+
+		bool encrypt(Aes_cbc_4k::Block_number const &block,
+		             Aes_cbc_4k::Plaintext const &plain,
+		             Aes_cbc_4k::Ciphertext &cipher)
+		{
+			Iv iv;
+			int len = 0;
+
+			bool const ok =
+			    _iv(block, iv)
+			 && EVP_EncryptInit_ex(_encrypt, nullptr, nullptr, nullptr, iv.values)
+			 && EVP_EncryptUpdate(_encrypt,
+			                      reinterpret_cast<unsigned char *>(cipher.values), &len,
+			                      reinterpret_cast<unsigned char const *>(plain.values),
+			                      sizeof(plain.values))
+			 && len == sizeof(cipher.values);
+
+			cleanup_crypto_data(iv);
+			return ok;
+		}
+
+		bool decrypt(Aes_cbc_4k::Block_number const &block,
+		             Aes_cbc_4k::Ciphertext const &cipher,
+		             Aes_cbc_4k::Plaintext &plain)
+		{
+			Iv iv;
+			int len = 0;
+
+			bool const ok =
+			    _iv(block, iv)
+			 && EVP_DecryptInit_ex(_decrypt, nullptr, nullptr, nullptr, iv.values)
+			 && EVP_DecryptUpdate(_decrypt,
+			                      reinterpret_cast<unsigned char *>(plain.values), &len,
+			                      reinterpret_cast<unsigned char const *>(cipher.values),
+			                      sizeof(cipher.values))
+			 && len == sizeof(plain.values);
+
+			cleanup_crypto_data(iv);
+			return ok;
+		}
+};
+
+
+/**
+ * Cache of the key schedules of recently used keys
+ */
+struct Key_schedule_cache
 {
-	static_assert(sizeof(plain.values)  == 4096, "Plain text size mismatch");
-	static_assert(sizeof(cipher.values) == 4096, "Cipher size mismatch");
-	static_assert(sizeof(key.values)    ==   32, "Key size mismatch");
+	Genode::Mutex mutex { };
 
-	AES_KEY aes_key;
-	if (AES_set_encrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting encrypt key");
-		return;
+	Aes_cbc::Key_schedule schedules[Aes_cbc::MAX_CACHED_KEYS];
+
+	unsigned long use_count = 0;
+
+	/**
+	 * Call 'fn' with the key schedule of 'key'
+	 *
+	 * If the key is not cached, the least recently used schedule is
+	 * replaced.
+	 *
+	 * \return false if the key could not be expanded
+	 */
+	template <typename FN>
+	bool with_schedule(Aes_cbc_4k::Key const &key, FN const &fn)
+	{
+		Genode::Mutex::Guard guard(mutex);
+
+		Aes_cbc::Key_schedule *schedule = nullptr;
+
+		for (Aes_cbc::Key_schedule &s : schedules)
+			if (s.matches(key))
+				schedule = &s;
+
+		if (!schedule) {
+			schedule = &schedules[0];
+			for (Aes_cbc::Key_schedule &s : schedules)
+				if (s.last_use < schedule->last_use)
+					schedule = &s;
+
+			if (!schedule->init(key))
+				return false;
+		}
+
+		schedule->last_use = ++use_count;
+
+		fn(*schedule);
+		return true;
 	}
 
-	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
+	void forget(Aes_cbc_4k::Key const &key)
+	{
+		Genode::Mutex::Guard guard(mutex);
+
+		for (Aes_cbc::Key_schedule &s : schedules)
+			if (s.matches(key)) {
+				s.wipe();
+				s.last_use = 0;
+			}
 	}
+};
 
-	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(plain.values),
-	                reinterpret_cast<unsigned char *>(cipher.values),
-	                sizeof(cipher.values), &aes_key, iv.values, AES_ENCRYPT);
 
-	/* clean up crypto relevant data which stays otherwise on stack */
-	cleanup_crypto_data(aes_key, iv);
+static Key_schedule_cache &key_schedule_cache()
+{
+	static Key_schedule_cache cache;
+	return cache;
 }
 
-void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
-                         Ciphertext const &cipher, Plaintext &plain)
+
+void Aes_cbc_4k::encrypt(Key const &key, Block_number const first,
+                         Plaintext const *plain, Ciphertext *cipher,
+                         unsigned const count)
+{
+	static_assert(sizeof(plain->values)  == 4096, "Plain text size mismatch");
+	static_assert(sizeof(cipher->values) == 4096, "Cipher size mismatch");
+	static_assert(sizeof(key.values)     ==   32, "Key size mismatch");
+
+	bool const key_ok = key_schedule_cache().with_schedule(key, [&] (Aes_cbc::Key_schedule &schedule) {
+
+		for (unsigned i = 0; i < count; i++)
+			if (!schedule.encrypt(Block_number { first.value + i }, plain[i], cipher[i])) {
+				Genode::error("encryption of block ", first.value + i);
+				return;
+			}
+	});
+
+	if (!key_ok)
+		Genode::error("setting encrypt key");
+}
+
+
+void Aes_cbc_4k::decrypt(Key const &key, Block_number const first,
+                         Ciphertext const *cipher, Plaintext *plain,
+                         unsigned const count)
 {
-	AES_KEY aes_key;
-	if (AES_set_decrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
+	bool const key_ok = key_schedule_cache().with_schedule(key, [&] (Aes_cbc::Key_schedule &schedule) {
+
+		for (unsigned i = 0; i < count; i++)
+			if (!schedule.decrypt(Block_number { first.value + i }, cipher[i], plain[i])) {
+				Genode::error("decryption of block ", first.value + i);
+				return;
+			}
+	});
+
+	if (!key_ok)
 		Genode::error("setting decrypt key");
-		return;
-	}
+}
 
-	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
-	}
 
-	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(cipher.values),
-	                reinterpret_cast<unsigned char *>(plain.values),
-	                sizeof(plain.values), &aes_key, iv.values, AES_DECRYPT);
+void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
+                         Plaintext const &plain, Ciphertext &cipher)
+{
+	encrypt(key, block_number, &plain, &cipher, 1);
+}
+
 
-	cleanup_crypto_data(aes_key, iv);
+void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
+                         Ciphertext const &cipher, Plaintext &plain)
+{
+	decrypt(key, block_number, &cipher, &plain, 1);
+}
+
+
+void Aes_cbc_4k::forget(Key const &key)
+{
+	key_schedule_cache().forget(key);
 }
@@ -149,6 +149,10 @@ struct Crypto : Cbe_crypto::Interface
 	bool remove_key(uint32_t const id) override
 	{
 		return apply_key (id, [&] (auto &meta) {
+
+			/* wipe the cached key schedule as well */
+			Aes_cbc_4k::forget(meta.key);
+
 			Genode::memset(meta.key.values, 0, sizeof(meta.key.values));
 
 			meta.used = false;
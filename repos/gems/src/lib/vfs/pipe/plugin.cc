@@ -13,8 +13,8 @@
 
 #include <vfs/file_system_factory.h>
 #include <os/path.h>
-#include <os/ring_buffer.h>
 #include <base/registry.h>
+#include <util/string.h>
 
 namespace Vfs_pipe {
 	using namespace Vfs;
@@ -23,8 +23,15 @@ namespace Vfs_pipe {
 	typedef Vfs::File_io_service::Read_result Read_result;
 	typedef Genode::Path<32> Path;
 
-	enum { PIPE_BUF_SIZE = 8192U };
-	typedef Genode::Ring_buffer<unsigned char, PIPE_BUF_SIZE+1> Pipe_buffer;
+	enum { PIPE_BUF_SIZE = 8192U, PIPE_BUF_MAX_SIZE = 64*1024U };
+
+	struct Buffer_config
+	{
+		Genode::size_t size;      /* initial capacity of a pipe */
+		Genode::size_t max_size;  /* limit of growing the capacity */
+	};
+
+	class Pipe_buffer;
 
 	struct Pipe_handle;
 	typedef Genode::Fifo_element<Pipe_handle> Handle_element;
@@ -41,6 +48,127 @@ namespace Vfs_pipe {
 }
 
 
+/**
+ * Ring buffer of a pipe, which grows while a writer is ahead of the reader
+ */
+class Vfs_pipe::Pipe_buffer
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Pipe_buffer(Pipe_buffer const &);
+		Pipe_buffer &operator = (Pipe_buffer const &);
+
+		Genode::Allocator &_alloc;
+
+		Genode::size_t const _max_capacity;
+		Genode::size_t       _capacity;
+
+		char *_data;
+
+		Genode::size_t _head = 0;  /* offset of the next byte to read */
+		Genode::size_t _used = 0;
+
+		static char *_alloc_data(Genode::Allocator &alloc, Genode::size_t size)
+		{
+			char *data = nullptr;
+			if (!alloc.alloc(size, &data))
+				throw Genode::Out_of_ram();
+			return data;
+		}
+
+		/**
+		 * Copy 'n' bytes starting at 'offset' into 'dst', wrapping at the end
+		 */
+		void _copy_out(char *dst, Genode::size_t offset, Genode::size_t n) const
+		{
+			Genode::size_t const first = Genode::min(n, _capacity - offset);
+
+			Genode::memcpy(dst, _data + offset, first);
+			Genode::memcpy(dst + first, _data, n - first);
+		}
+
+	public:
+
+		Pipe_buffer(Genode::Allocator &alloc, Buffer_config config)
+		:
+			_alloc(alloc),
+			_max_capacity(config.max_size),
+			_capacity(config.size),
+			_data(_alloc_data(alloc, _capacity))
+		{ }
+
+		~Pipe_buffer() { _alloc.free(_data, _capacity); }
+
+		bool           empty()          const { return _used == 0; }
+		Genode::size_t used()           const { return _used; }
+		Genode::size_t avail_capacity() const { return _capacity - _used; }
+
+		/**
+		 * Double the capacity, up to the configured limit
+		 *
+		 * \return true if the buffer was enlarged
+		 */
+		bool grow()
+		{
+			if (_capacity >= _max_capacity)
+				return false;
+
+			Genode::size_t const capacity = Genode::min(2*_capacity, _max_capacity);
+
+			char *data = nullptr;
+			try { data = _alloc_data(_alloc, capacity); }
+			catch (Genode::Out_of_ram)  { return false; }
+			catch (Genode::Out_of_caps) { return false; }
+
+			_copy_out(data, _head, _used);
+			_alloc.free(_data, _capacity);
+
+			_data     = data;
+			_capacity = capacity;
+			_head     = 0;
+			return true;
+		}
+
+		/**
+		 * Append up to 'n' bytes
+		 *
+		 * \return number of appended bytes
+		 */
+		Genode::size_t write(char const *src, Genode::size_t n)
+		{
+			n = Genode::min(n, avail_capacity());
+
+			Genode::size_t const tail  = (_head + _used) % _capacity;
+			Genode::size_t const first = Genode::min(n, _capacity - tail);
+
+			Genode::memcpy(_data + tail, src, first);
+			Genode::memcpy(_data, src + first, n - first);
+
+			_used += n;
+			return n;
+		}
+
+		/**
+		 * Consume up to 'n' bytes
+		 *
+		 * \return number of consumed bytes
+		 */
+		Genode::size_t read(char *dst, Genode::size_t n)
+		{
+			n = Genode::min(n, _used);
+
+			_copy_out(dst, _head, n);
+
+			_head  = (_head + n) % _capacity;
+			_used -= n;
+			return n;
+		}
+};
+
+
 struct Vfs_pipe::Pipe_handle : Vfs::Vfs_handle, private Pipe_handle_registry_element
 {
 	Pipe &pipe;
@@ -81,7 +209,7 @@ struct Vfs_pipe::Pipe
 {
 	Genode::Allocator &alloc;
 	Pipe_space::Element space_elem;
-	Pipe_buffer buffer { };
+	Pipe_buffer buffer;
 	Pipe_handle_registry registry { };
 	Handle_fifo io_progress_waiters { };
 	Handle_fifo read_ready_waiters { };
@@ -92,8 +220,12 @@ struct Vfs_pipe::Pipe
 	bool new_handle_active { true };
 
 	Pipe(Genode::Allocator &alloc, Pipe_space &space,
-	     Genode::Signal_context_capability &notify_sigh)
-	: alloc(alloc), space_elem(*this, space), notify_sigh(notify_sigh) { }
+	     Genode::Signal_context_capability &notify_sigh,
+	     Buffer_config buffer_config)
+	:
+		alloc(alloc), space_elem(*this, space),
+		buffer(alloc, buffer_config), notify_sigh(notify_sigh)
+	{ }
 
 	~Pipe() { }
 
@@ -179,13 +311,16 @@ struct Vfs_pipe::Pipe
 	                   const char *buf, file_size count,
 	                   file_size &out_count)
 	{
-		file_size out = 0;
 		bool notify = buffer.empty();
 
-		while (out < count && 0 < buffer.avail_capacity()) {
-			buffer.add(*(buf++));
-			++out;
-		}
+		/* make room for writers that are ahead of the reader */
+		while (buffer.avail_capacity() < count)
+			if (!buffer.grow())
+				break;
+
+		file_size const out =
+			buffer.write(buf, (Genode::size_t)Genode::min(count,
+			                                              (file_size)buffer.avail_capacity()));
 
 		out_count = out;
 		if (out < count)
@@ -203,11 +338,9 @@ struct Vfs_pipe::Pipe
 	{
 		bool notify = buffer.avail_capacity() == 0;
 
-		file_size out = 0;
-		while (out < count && !buffer.empty()) {
-			*(buf++) = buffer.get();
-			++out;
-		}
+		file_size const out =
+			buffer.read(buf, (Genode::size_t)Genode::min(count,
+			                                             (file_size)buffer.used()));
 
 		out_count = out;
 		if (!out) {
@@ -267,9 +400,10 @@ struct Vfs_pipe::New_pipe_handle : Vfs::Vfs_handle
 	                Genode::Allocator &alloc,
 	                unsigned flags,
 	                Pipe_space &pipe_space,
-	                Genode::Signal_context_capability &notify_sigh)
+	                Genode::Signal_context_capability &notify_sigh,
+	                Buffer_config buffer_config)
 	: Vfs::Vfs_handle(fs, fs, alloc, flags),
-	  pipe(*(new (alloc) Pipe(alloc, pipe_space, notify_sigh)))
+	  pipe(*(new (alloc) Pipe(alloc, pipe_space, notify_sigh, buffer_config)))
 	{ }
 
 	~New_pipe_handle()
@@ -298,6 +432,23 @@ class Vfs_pipe::File_system : public Vfs::File_system
 
 		Pipe_space _pipe_space { };
 
+		Buffer_config const _buffer_config;
+
+		static Buffer_config _buffer_config_from_xml(Genode::Xml_node config)
+		{
+			using Genode::Number_of_bytes;
+			using Genode::size_t;
+
+			size_t const size =
+				config.attribute_value("buffer_size", Number_of_bytes(PIPE_BUF_SIZE));
+
+			size_t const max_size =
+				config.attribute_value("max_buffer_size", Number_of_bytes(PIPE_BUF_MAX_SIZE));
+
+			return Buffer_config { .size     = Genode::max(size, (size_t)1),
+			                       .max_size = Genode::max(size, max_size) };
+		}
+
 		/*
 		 * XXX: a hack to defer cross-thread notifications at
 		 * the libc until the io_progress handler
@@ -313,8 +464,11 @@ class Vfs_pipe::File_system : public Vfs::File_system
 
 	public:
 
-		File_system(Vfs::Env &env)
-		: _notify_handler(env.env().ep(), *this, &File_system::_notify_any) { }
+		File_system(Vfs::Env &env, Genode::Xml_node config)
+		:
+			_buffer_config(_buffer_config_from_xml(config)),
+			_notify_handler(env.env().ep(), *this, &File_system::_notify_any)
+		{ }
 
 		const char* type() override { return "pipe"; }
 
@@ -338,7 +492,8 @@ class Vfs_pipe::File_system : public Vfs::File_system
 				if ((Directory_service::OPEN_MODE_ACCMODE & mode) == Directory_service::OPEN_MODE_WRONLY)
 					return Open_result::OPEN_ERR_NO_PERM;
 				*handle = new (alloc)
-					New_pipe_handle(*this, alloc, mode, _pipe_space, _notify_cap);
+					New_pipe_handle(*this, alloc, mode, _pipe_space, _notify_cap,
+					                _buffer_config);
 				return Open_result::OPEN_OK;
 			}
 
@@ -477,8 +632,7 @@ class Vfs_pipe::File_system : public Vfs::File_system
 						} else
 						if (filename == "/out") {
 							out = Stat {
-								.size              = file_size(PIPE_BUF_SIZE
-								                             - pipe.buffer.avail_capacity()),
+								.size              = file_size(pipe.buffer.used()),
 								.type              = Node_type::CONTINUOUS_FILE,
 								.rwx               = Node_rwx::ro(),
 								.inode             = Genode::addr_t(&pipe) + 2,
@@ -610,10 +764,10 @@ extern "C" Vfs::File_system_factory *vfs_file_system_factory(void)
 {
 	struct Factory : Vfs::File_system_factory
 	{
-		Vfs::File_system *create(Vfs::Env &env, Genode::Xml_node) override
+		Vfs::File_system *create(Vfs::Env &env, Genode::Xml_node config) override
 		{
 			return new (env.alloc())
-				Vfs_pipe::File_system(env);
+				Vfs_pipe::File_system(env, config);
 		}
 	};
 
@@ -0,0 +1,211 @@
+/*
+ * \brief  Benchmark of the aes_cbc_4k throughput
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark compares the processing of single blocks, of batches of
+ * blocks with consecutive block numbers, and of single blocks with the key
+ * schedule dropped after each block, which corresponds to the cost of the
+ * key expansion per block. Each variant must reproduce the ciphertext of a
+ * reference encryption, which expands the key schedule anew for each block,
+ * and must decrypt its ciphertext to the original plaintext.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+
+#include <libc/component.h>
+
+#include <aes_cbc_4k/aes_cbc_4k.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Timer::Stopwatch;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum { MAX_BATCH = 64 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Stopwatch _stopwatch { _timer };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	unsigned const _blocks = _config.xml().attribute_value("blocks", 4096U);
+
+	Aes_cbc_4k::Key _key { };
+
+	Aes_cbc_4k::Plaintext  * const _plain =
+		new (_heap) Aes_cbc_4k::Plaintext [MAX_BATCH];
+
+	Aes_cbc_4k::Ciphertext * const _cipher =
+		new (_heap) Aes_cbc_4k::Ciphertext[MAX_BATCH];
+
+	Aes_cbc_4k::Plaintext  * const _decrypted =
+		new (_heap) Aes_cbc_4k::Plaintext [MAX_BATCH];
+
+	Aes_cbc_4k::Ciphertext * const _reference =
+		new (_heap) Aes_cbc_4k::Ciphertext[MAX_BATCH];
+
+	/**
+	 * Return throughput in KiB/s
+	 */
+	uint64_t _rate(uint64_t us) const
+	{
+		return Stopwatch::rate(_blocks*sizeof(Aes_cbc_4k::Block)/1024, us);
+	}
+
+	bool _check(unsigned count)
+	{
+		if (!memcmp(_plain, _decrypted, count*sizeof(Aes_cbc_4k::Plaintext)))
+			return true;
+
+		error("plaintext differs from decrypted ciphertext");
+		return false;
+	}
+
+	/**
+	 * Return true if the blocks 0 to MAX_BATCH - 1 match the reference
+	 */
+	bool _check_cipher()
+	{
+		if (!memcmp(_cipher, _reference, MAX_BATCH*sizeof(Aes_cbc_4k::Ciphertext)))
+			return true;
+
+		error("ciphertext differs from reference");
+		return false;
+	}
+
+	bool _bench_single(bool forget)
+	{
+		uint64_t const encrypt_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _blocks; i++) {
+				Aes_cbc_4k::encrypt(_key, Aes_cbc_4k::Block_number { i },
+				                    _plain[i % MAX_BATCH], _cipher[i % MAX_BATCH]);
+				if (forget)
+					Aes_cbc_4k::forget(_key);
+			}
+		});
+
+		uint64_t const decrypt_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _blocks; i++) {
+				Aes_cbc_4k::decrypt(_key, Aes_cbc_4k::Block_number { i },
+				                    _cipher[i % MAX_BATCH], _decrypted[i % MAX_BATCH]);
+				if (forget)
+					Aes_cbc_4k::forget(_key);
+			}
+		});
+
+		if (!_check(min(_blocks, (unsigned)MAX_BATCH)))
+			return false;
+
+		for (unsigned i = 0; i < MAX_BATCH; i++) {
+			Aes_cbc_4k::encrypt(_key, Aes_cbc_4k::Block_number { i },
+			                    _plain[i], _cipher[i]);
+			if (forget)
+				Aes_cbc_4k::forget(_key);
+		}
+
+		if (!_check_cipher())
+			return false;
+
+		log(forget ? "uncached" : "single", ": ",
+		    "encrypt ", _rate(encrypt_us), " KiB/s, ",
+		    "decrypt ", _rate(decrypt_us), " KiB/s");
+		return true;
+	}
+
+	bool _bench_batch(unsigned const batch)
+	{
+		uint64_t const encrypt_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _blocks; i += batch)
+				Aes_cbc_4k::encrypt(_key, Aes_cbc_4k::Block_number { i },
+				                    _plain, _cipher, min(batch, _blocks - i));
+		});
+
+		uint64_t const decrypt_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _blocks; i += batch)
+				Aes_cbc_4k::decrypt(_key, Aes_cbc_4k::Block_number { i },
+				                    _cipher, _decrypted, min(batch, _blocks - i));
+		});
+
+		if (!_check(min(_blocks, batch)))
+			return false;
+
+		for (unsigned i = 0; i < MAX_BATCH; i += batch)
+			Aes_cbc_4k::encrypt(_key, Aes_cbc_4k::Block_number { i },
+			                    _plain + i, _cipher + i, min(batch, MAX_BATCH - i));
+
+		if (!_check_cipher())
+			return false;
+
+		log("batch of ", batch, ": ",
+		    "encrypt ", _rate(encrypt_us), " KiB/s, ",
+		    "decrypt ", _rate(decrypt_us), " KiB/s");
+		return true;
+	}
+
+	bool _run()
+	{
+		for (unsigned i = 0; i < sizeof(_key.values); i++)
+			_key.values[i] = (char)(i*7 + 3);
+
+		for (unsigned i = 0; i < MAX_BATCH; i++)
+			for (unsigned j = 0; j < sizeof(_plain[i].values); j++)
+				_plain[i].values[j] = (char)(i + j*13);
+
+		for (unsigned i = 0; i < MAX_BATCH; i++) {
+			Aes_cbc_4k::encrypt(_key, Aes_cbc_4k::Block_number { i },
+			                    _plain[i], _reference[i]);
+			Aes_cbc_4k::forget(_key);
+		}
+
+		bool const ok = _bench_single(false)
+		             && _bench_batch(16)
+		             && _bench_batch(MAX_BATCH)
+		             && _bench_single(true);
+
+		Aes_cbc_4k::forget(_key);
+
+		return ok;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_env.parent().exit(_run() ? 0 : -1);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Libc::Component::construct(Libc::Env &env)
+{
+	Libc::with_libc([&] { static Test::Main main(env); });
+}
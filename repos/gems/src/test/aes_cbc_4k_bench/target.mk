@@ -0,0 +1,3 @@
+TARGET := test-aes_cbc_4k_bench
+SRC_CC := main.cc
+LIBS   += base libc aes_cbc_4k
@@ -26,6 +26,7 @@
 #include <sys/poll.h>   /* for 'struct pollfd' */
 
 namespace Genode { class Env; }
+namespace Vfs { class Vfs_handle; }
 
 namespace Libc {
 
@@ -75,6 +76,7 @@ namespace Libc {
 			virtual bool supports_symlink(const char *oldpath, const char *newpath);
 			virtual bool supports_unlink(const char *path);
 			virtual bool supports_mmap();
+			virtual bool supports_kqueue();
 
 			/*
 			 * Should be overwritten for plugins that require the Genode environment
@@ -145,6 +147,19 @@ namespace Libc {
 			virtual int symlink(const char *oldpath, const char *newpath);
 			virtual int unlink(const char *path);
 			virtual ssize_t write(File_descriptor *, const void *buf, ::size_t count);
+
+			/*
+			 * Readiness interface used by 'kevent'
+			 *
+			 * The functions are called from within a monitor function. If
+			 * 'read_ready' returns false, the plugin has requested a
+			 * read-ready response at the VFS handle returned by
+			 * 'readiness_handle'. The caller observes the responses of this
+			 * handle to learn when to look at the file descriptor again.
+			 */
+			virtual bool read_ready(File_descriptor *);
+			virtual bool write_ready(File_descriptor *);
+			virtual Vfs::Vfs_handle *readiness_handle(File_descriptor *, bool write);
 	};
 }
 
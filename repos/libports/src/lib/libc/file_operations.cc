@@ -45,6 +45,7 @@ extern "C" {
 #include <internal/errno.h>
 #include <internal/init.h>
 #include <internal/cwd.h>
+#include <internal/kqueue.h>
 
 using namespace Libc;
 
@@ -260,6 +261,8 @@ __SYS_(int, close, (int libc_fd),
 	if (!fd)
 		return Errno(EBADF);
 
+	kqueue_fd_closed(*fd);
+
 	if (!fd->plugin || fd->plugin->close(fd) != 0)
 		file_descriptor_allocator()->free(fd);
 
@@ -74,6 +74,11 @@ namespace Libc {
 	 */
 	void init_select(Select &, Signal &, Monitor &);
 
+	/**
+	 * Kqueue support
+	 */
+	void init_kqueue(Signal &, Monitor &);
+
 	/**
 	 * Support for querying available RAM quota in sysctl functions
 	 */
@@ -91,11 +96,18 @@ namespace Libc {
 
 	/**
 	 * Malloc allocator
+	 *
+	 * \param thread_caches  use per-thread caches of small blocks
 	 */
-	void init_malloc(Genode::Allocator &);
+	void init_malloc(Genode::Allocator &, bool thread_caches);
 	void init_malloc_cloned(Clone_connection &);
 	void reinit_malloc(Genode::Allocator &);
 
+	/**
+	 * Return malloc blocks cached by the calling thread
+	 */
+	void release_malloc_thread_cache();
+
 	typedef String<Vfs::MAX_PATH_LEN> Rtc_path;
 
 	/**
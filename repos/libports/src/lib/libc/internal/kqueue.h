@@ -0,0 +1,29 @@
+/*
+ * \brief  Interface between kqueue and the generic file operations
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__KQUEUE_H_
+#define _LIBC__INTERNAL__KQUEUE_H_
+
+namespace Libc {
+
+	class File_descriptor;
+
+	/**
+	 * Remove all events registered for 'fd' from all kqueues
+	 *
+	 * Must be called before the plugin releases the file descriptor.
+	 */
+	void kqueue_fd_closed(File_descriptor &fd);
+}
+
+#endif /* _LIBC__INTERNAL__KQUEUE_H_ */
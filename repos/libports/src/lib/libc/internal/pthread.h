@@ -28,6 +28,7 @@
 
 /* libc-internal includes */
 #include <internal/types.h>
+#include <internal/init.h>
 #include <internal/monitor.h>
 #include <internal/timer.h>
 
@@ -267,6 +268,7 @@ struct Libc::Pthread : Noncopyable, Thread::Tls::Base
 		{
 			while (cleanup_pop(1)) { }
 			_retval = retval;
+			release_malloc_thread_cache();
 			cancel();
 
 			/*
@@ -189,6 +189,7 @@ class Libc::Vfs_plugin : public Plugin
 		bool supports_symlink(const char *, const char *)      override { return true; }
 		bool supports_unlink(const char *)                     override { return true; }
 		bool supports_mmap()                                   override { return true; }
+		bool supports_kqueue()                                 override { return true; }
 
 		bool supports_select(int nfds,
 		                     fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
@@ -227,6 +228,9 @@ class Libc::Vfs_plugin : public Plugin
 		void   *mmap(void *, ::size_t, int, int, File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
 		int     select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout) override;
+		bool    read_ready(File_descriptor *) override;
+		bool    write_ready(File_descriptor *) override;
+		Vfs::Vfs_handle *readiness_handle(File_descriptor *, bool) override;
 };
 
 #endif /* _LIBC__INTERNAL__VFS_PLUGIN_H_ */
@@ -62,6 +62,7 @@ void Libc::Kernel::reset_malloc_heap()
 
 	Heap &raw_malloc_heap = *_malloc_heap;
 	construct_at<Heap>(&raw_malloc_heap, *_malloc_ram, _env.rm());
+	raw_malloc_heap.enable_bins();
 
 	reinit_malloc(raw_malloc_heap);
 }
@@ -464,7 +465,9 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 
 	} else {
 		_malloc_heap.construct(*_malloc_ram, _env.rm());
-		init_malloc(*_malloc_heap);
+		_malloc_heap->enable_bins();
+		init_malloc(*_malloc_heap,
+		            _libc_env.libc_config().attribute_value("malloc_thread_caches", true));
 	}
 
 	init_fork(_env, _libc_env, _heap, *_malloc_heap, _pid, *this, _signal,
@@ -477,6 +480,7 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 	init_file_operations(*this, _libc_env);
 	init_time(*this, *this);
 	init_select(*this, _signal, *this);
+	init_kqueue(_signal, *this);
 	init_socket_fs(*this, *this);
 	init_passwd(_passwd_config());
 	init_signal(_signal);
@@ -0,0 +1,615 @@
+/*
+ * \brief  kqueue() and kevent() implementation
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * In contrast to 'select' and 'poll', which scan all file descriptors of
+ * interest on each call and on each I/O signal, a kqueue keeps its
+ * registered events (knotes) across calls. A knote is observing the VFS
+ * handle that backs its file descriptor. Each response of this handle puts
+ * the knote onto the ready queue of its kqueue. Hence, the costs of 'kevent'
+ * depend on the number of events that became ready, not on the number of
+ * registered file descriptors.
+ *
+ * The state of all kqueues is accessed from monitor functions only. Those
+ * are executed by the libc kernel, which is also the context that delivers
+ * the VFS responses. Therefore, no locking is needed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/id_space.h>
+#include <util/avl_tree.h>
+#include <util/fifo.h>
+#include <util/list.h>
+#include <vfs/vfs_handle.h>
+
+/* libc plugin interface */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
+
+/* libc includes */
+#include <libc/allocator.h>
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+#include <errno.h>
+
+/* libc-internal includes */
+#include <internal/kernel.h>
+#include <internal/init.h>
+#include <internal/signal.h>
+#include <internal/errno.h>
+#include <internal/monitor.h>
+#include <internal/kqueue.h>
+
+namespace Libc {
+	struct Knote;
+	struct Knote_watch;
+	struct Kqueue;
+	struct Kqueue_plugin;
+}
+
+using namespace Libc;
+
+
+static Libc::Signal *_signal_ptr;
+static Monitor      *_monitor_ptr;
+
+
+void Libc::init_kqueue(Signal &signal, Monitor &monitor)
+{
+	_signal_ptr  = &signal;
+	_monitor_ptr = &monitor;
+}
+
+
+static Monitor &monitor()
+{
+	struct Missing_call_of_init_kqueue : Exception { };
+	if (!_monitor_ptr || !_signal_ptr)
+		throw Missing_call_of_init_kqueue();
+	return *_monitor_ptr;
+}
+
+
+namespace { using Fn = Monitor::Function_result; }
+
+
+/**
+ * Execute 'fn' in the context of the libc kernel
+ */
+template <typename FN>
+static void with_monitor(FN const &fn)
+{
+	if (Libc::Kernel::kernel().main_context() && Libc::Kernel::kernel().main_suspended()) {
+		fn();
+	} else {
+		monitor().monitor([&] { fn(); return Fn::COMPLETE; });
+	}
+}
+
+
+struct Libc::Knote : Fifo<Knote>::Element, List<Knote>::Element
+{
+	typedef Id_space<Knote> Knotes;
+
+	static Knotes::Id id(int fd, short filter)
+	{
+		return Knotes::Id { (unsigned long)fd*2 + (filter == EVFILT_WRITE) };
+	}
+
+	Kqueue &kqueue;
+
+	Knotes::Element _elem;
+
+	File_descriptor &fd;
+	short     const  filter;
+
+	unsigned short flags   = 0;   /* EV_CLEAR, EV_ONESHOT, EV_DISPATCH */
+	unsigned int   fflags  = 0;
+	void          *udata   = nullptr;
+	bool           enabled = true;
+
+	Knote_watch *watch = nullptr;
+
+	Knote(Kqueue &kqueue, Knotes &knotes, File_descriptor &fd, short filter)
+	:
+		kqueue(kqueue), _elem(*this, knotes, id(fd.libc_fd, filter)),
+		fd(fd), filter(filter)
+	{ }
+
+	bool write() const { return filter == EVFILT_WRITE; }
+
+	bool ready()
+	{
+		return write() ? fd.plugin->write_ready(&fd)
+		               : fd.plugin->read_ready(&fd);
+	}
+
+	/**
+	 * Return the event to report to the application
+	 *
+	 * The amount of readable data is not known. We report 1 as lower bound.
+	 */
+	struct kevent event() const
+	{
+		struct kevent ev { };
+		EV_SET(&ev, fd.libc_fd, filter, flags, fflags, 1, udata);
+		return ev;
+	}
+
+	/* Noncopyable */
+	Knote(Knote const &);
+	Knote &operator = (Knote const &);
+};
+
+
+/**
+ * Interposer of the response handler of a VFS handle
+ *
+ * There exists at most one watch per VFS handle. It forwards the responses
+ * to the original handler and wakes up all knotes that observe the handle.
+ */
+struct Libc::Knote_watch : Vfs::Io_response_handler, Avl_node<Knote_watch>
+{
+	Vfs::Vfs_handle &handle;
+
+	Vfs::Io_response_handler *_orig = nullptr;
+
+	List<Knote> knotes { };
+
+	Knote_watch(Vfs::Vfs_handle &handle) : handle(handle)
+	{
+		handle.apply_handler([&] (Vfs::Io_response_handler &h) { _orig = &h; });
+		handle.handler(this);
+	}
+
+	~Knote_watch() { handle.handler(_orig); }
+
+	void _wakeup();
+
+	/**
+	 * Io_response_handler interface
+	 */
+	void read_ready_response() override
+	{
+		_wakeup();
+		if (_orig) _orig->read_ready_response();
+	}
+
+	/**
+	 * Io_response_handler interface
+	 */
+	void io_progress_response() override
+	{
+		_wakeup();
+		if (_orig) _orig->io_progress_response();
+	}
+
+	/**
+	 * Avl_node interface
+	 */
+	bool higher(Knote_watch *w) { return (addr_t)&w->handle > (addr_t)&handle; }
+
+	Knote_watch *find(Vfs::Vfs_handle const &h)
+	{
+		if (&h == &handle) return this;
+
+		Knote_watch *w = Avl_node<Knote_watch>::child((addr_t)&h > (addr_t)&handle);
+		return w ? w->find(h) : nullptr;
+	}
+
+	/* Noncopyable */
+	Knote_watch(Knote_watch const &);
+	Knote_watch &operator = (Knote_watch const &);
+};
+
+
+static Avl_tree<Knote_watch> &knote_watches()
+{
+	static Avl_tree<Knote_watch> watches { };
+	return watches;
+}
+
+
+struct Libc::Kqueue : Plugin_context, List<Kqueue>::Element
+{
+	Knote::Knotes _knotes { };
+
+	Fifo<Knote> _ready { };
+
+	/**
+	 * Let 'knote' observe the VFS handle that currently signals its readiness
+	 *
+	 * The handle is looked up each time because it may change with the
+	 * state of the file descriptor, e.g., for a connecting socket.
+	 */
+	void _attach(Knote &knote)
+	{
+		Vfs::Vfs_handle *handle =
+			knote.fd.plugin->readiness_handle(&knote.fd, knote.write());
+
+		if (knote.watch && handle == &knote.watch->handle)
+			return;
+
+		_detach(knote);
+
+		if (!handle)
+			return;
+
+		Libc::Allocator alloc { };
+
+		Knote_watch *watch = knote_watches().first()
+		                   ? knote_watches().first()->find(*handle) : nullptr;
+		if (!watch) {
+			watch = new (alloc) Knote_watch(*handle);
+			knote_watches().insert(watch);
+		}
+
+		watch->knotes.insert(&knote);
+		knote.watch = watch;
+	}
+
+	void _detach(Knote &knote)
+	{
+		Knote_watch *watch = knote.watch;
+		if (!watch)
+			return;
+
+		watch->knotes.remove(&knote);
+		knote.watch = nullptr;
+
+		if (watch->knotes.first())
+			return;
+
+		knote_watches().remove(watch);
+
+		Libc::Allocator alloc { };
+		destroy(alloc, watch);
+	}
+
+	void _destroy(Knote &knote)
+	{
+		if (knote.enqueued())
+			_ready.remove(knote);
+
+		_detach(knote);
+
+		Libc::Allocator alloc { };
+		destroy(alloc, &knote);
+	}
+
+	template <typename FN>
+	bool _with_knote(int fd, short filter, FN const &fn)
+	{
+		try {
+			_knotes.apply<Knote>(Knote::id(fd, filter), fn);
+			return true;
+		}
+		catch (Knote::Knotes::Unknown_id) { return false; }
+	}
+
+	/**
+	 * Apply change to the registered events
+	 *
+	 * \return 0 on success or errno value
+	 */
+	int apply(struct kevent const &change)
+	{
+		if (change.filter != EVFILT_READ && change.filter != EVFILT_WRITE)
+			return EINVAL;
+
+		int const libc_fd = (int)change.ident;
+
+		File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+		if (!fd || !fd->plugin)
+			return EBADF;
+
+		Knote *knote = nullptr;
+		_with_knote(libc_fd, change.filter, [&] (Knote &k) { knote = &k; });
+
+		if (change.flags & EV_DELETE) {
+			if (!knote)
+				return ENOENT;
+
+			_destroy(*knote);
+			return 0;
+		}
+
+		if (!knote) {
+			if (!(change.flags & EV_ADD))
+				return ENOENT;
+
+			if (!fd->plugin->supports_kqueue())
+				return EINVAL;
+
+			Libc::Allocator alloc { };
+			knote = new (alloc) Knote(*this, _knotes, *fd, change.filter);
+		}
+
+		if (change.flags & EV_ADD) {
+			knote->flags  = change.flags & (EV_CLEAR | EV_ONESHOT | EV_DISPATCH);
+			knote->fflags = change.fflags;
+			knote->udata  = change.udata;
+		}
+
+		if (change.flags & EV_DISABLE) {
+			knote->enabled = false;
+			return 0;
+		}
+
+		if (change.flags & (EV_ADD | EV_ENABLE)) {
+			knote->enabled = true;
+			_attach(*knote);
+			wakeup(*knote);
+		}
+		return 0;
+	}
+
+	void wakeup(Knote &knote)
+	{
+		if (!knote.enqueued())
+			_ready.enqueue(knote);
+	}
+
+	/**
+	 * Report ready events
+	 *
+	 * Only knotes that were woken up are examined. Knotes that are not
+	 * ready (anymore) leave the queue until the next response of their
+	 * VFS handle. Level-triggered knotes that are ready stay in the queue
+	 * and are examined again at the next call.
+	 *
+	 * \return number of events stored in 'events'
+	 */
+	int collect(struct kevent *events, int max_events)
+	{
+		Fifo<Knote> still_ready { };
+
+		int n = 0;
+		while (n < max_events) {
+
+			Knote *knote = nullptr;
+			_ready.dequeue([&] (Knote &k) { knote = &k; });
+
+			if (!knote)
+				break;
+
+			if (!knote->enabled)
+				continue;
+
+			/* observe handle prior the check to not miss a response */
+			_attach(*knote);
+
+			if (!knote->ready())
+				continue;
+
+			events[n++] = knote->event();
+
+			if (knote->flags & EV_ONESHOT) {
+				_destroy(*knote);
+				continue;
+			}
+
+			if (knote->flags & EV_DISPATCH)
+				knote->enabled = false;
+
+			if (knote->flags & (EV_CLEAR | EV_DISPATCH)) {
+
+				/* request response on the arrival of new data */
+				if (!knote->write() && knote->watch)
+					knote->watch->handle.fs().notify_read_ready(&knote->watch->handle);
+				continue;
+			}
+
+			still_ready.enqueue(*knote);
+		}
+
+		still_ready.dequeue_all([&] (Knote &knote) { _ready.enqueue(knote); });
+
+		return n;
+	}
+
+	/**
+	 * Remove all knotes of file descriptor
+	 */
+	void forget(int fd)
+	{
+		_with_knote(fd, EVFILT_READ,  [&] (Knote &knote) { _destroy(knote); });
+		_with_knote(fd, EVFILT_WRITE, [&] (Knote &knote) { _destroy(knote); });
+	}
+
+	~Kqueue()
+	{
+		while (_knotes.apply_any<Knote>([&] (Knote &knote) { _destroy(knote); }));
+	}
+};
+
+
+void Libc::Knote_watch::_wakeup()
+{
+	for (Knote *k = knotes.first(); k; k = k->List<Knote>::Element::next())
+		k->kqueue.wakeup(*k);
+}
+
+
+/*
+ * List of all kqueues, accessed from monitor functions only
+ */
+static List<Kqueue> &kqueues()
+{
+	static List<Kqueue> list { };
+	return list;
+}
+
+
+static unsigned _num_kqueues;
+
+
+void Libc::kqueue_fd_closed(File_descriptor &fd)
+{
+	if (!_num_kqueues)
+		return;
+
+	with_monitor([&] {
+		for (Kqueue *kq = kqueues().first(); kq; kq = kq->next())
+			kq->forget(fd.libc_fd);
+	});
+}
+
+
+struct Libc::Kqueue_plugin : Plugin
+{
+	int close(File_descriptor *fd) override
+	{
+		Kqueue *kq = dynamic_cast<Kqueue *>(fd->context);
+		if (!kq)
+			return Errno(EBADF);
+
+		with_monitor([&] {
+			kqueues().remove(kq);
+			_num_kqueues--;
+
+			Libc::Allocator alloc { };
+			destroy(alloc, kq);
+		});
+
+		file_descriptor_allocator()->free(fd);
+		return 0;
+	}
+};
+
+
+extern "C" int kqueue(void)
+{
+	static Kqueue_plugin plugin;
+
+	Libc::Allocator alloc { };
+	Kqueue *kq = new (alloc) Kqueue();
+
+	File_descriptor *fd = file_descriptor_allocator()->alloc(&plugin, kq, ANY_FD);
+	if (!fd) {
+		destroy(alloc, kq);
+		return Errno(EMFILE);
+	}
+
+	with_monitor([&] {
+		kqueues().insert(kq);
+		_num_kqueues++;
+	});
+
+	return fd->libc_fd;
+}
+
+
+extern "C" int __sys_kevent(int libc_fd,
+                            struct kevent const *changelist, int nchanges,
+                            struct kevent *eventlist, int nevents,
+                            struct timespec const *timeout)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+
+	Kqueue *kq = fd ? dynamic_cast<Kqueue *>(fd->context) : nullptr;
+	if (!kq)
+		return Errno(EBADF);
+
+	if (nchanges < 0 || nevents < 0)
+		return Errno(EINVAL);
+
+	/*
+	 * Apply changes, errors are reported as events if there is space left
+	 */
+	int n     = 0;
+	int error = 0;
+	with_monitor([&] {
+		for (int i = 0; i < nchanges && !error; i++) {
+
+			struct kevent const &change = changelist[i];
+
+			int const result = kq->apply(change);
+
+			if (!result && !(change.flags & EV_RECEIPT))
+				continue;
+
+			if (n < nevents) {
+				eventlist[n]       = change;
+				eventlist[n].flags = EV_ERROR;
+				eventlist[n].data  = result;
+				n++;
+			} else {
+				error = result;
+			}
+		}
+	});
+
+	if (error)
+		return Errno(error);
+
+	if (n || !nevents)
+		return n;
+
+	with_monitor([&] { n = kq->collect(eventlist, nevents); });
+
+	bool const no_wait = timeout && timeout->tv_sec == 0 && timeout->tv_nsec == 0;
+
+	if (n || no_wait)
+		return n;
+
+	using Genode::uint64_t;
+
+	/* round up to not turn short timeouts into an infinite wait */
+	uint64_t const timeout_ms = timeout
+	                          ? (uint64_t)timeout->tv_sec*1000
+	                            + ((uint64_t)timeout->tv_nsec + 999999)/1000000
+	                          : 0UL;
+
+	unsigned const orig_signal_count = _signal_ptr->count();
+
+	auto signal_occurred_during_kevent = [&] ()
+	{
+		return (_signal_ptr->count() != orig_signal_count);
+	};
+
+	auto monitor_fn = [&] ()
+	{
+		n = kq->collect(eventlist, nevents);
+
+		if (n || signal_occurred_during_kevent())
+			return Fn::COMPLETE;
+
+		return Fn::INCOMPLETE;
+	};
+
+	Monitor::Result const monitor_result = monitor().monitor(monitor_fn, timeout_ms);
+
+	if (n)
+		return n;
+
+	if (monitor_result == Monitor::Result::TIMEOUT)
+		return 0;
+
+	if (signal_occurred_during_kevent())
+		return Errno(EINTR);
+
+	return 0;
+}
+
+
+extern "C" __attribute__((alias("__sys_kevent")))
+int __libc_kevent(int, struct kevent const *, int, struct kevent *, int,
+                  struct timespec const *);
+
+extern "C" __attribute__((alias("__sys_kevent")))
+int _kevent(int, struct kevent const *, int, struct kevent *, int,
+            struct timespec const *);
+
+extern "C" __attribute__((alias("__sys_kevent")))
+int kevent(int, struct kevent const *, int, struct kevent *, int,
+           struct timespec const *);
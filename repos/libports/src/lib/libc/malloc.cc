@@ -16,6 +16,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -88,6 +89,12 @@ class Libc::Malloc
 			DEFAULT_ALIGN = 16
 		};
 
+		enum {
+			NUM_THREAD_CACHES     = 64,
+			CACHE_BYTES_PER_SLAB  = 16*1024, /* upper bound of cached bytes */
+			MIN_CACHED_PER_SLAB   = 8,       /* lower bound of cached blocks */
+		};
+
 		struct Metadata
 		{
 			size_t size;
@@ -127,6 +134,182 @@ class Libc::Malloc
 
 		Mutex _mutex;
 
+		/**
+		 * Per-thread cache of free slab blocks
+		 *
+		 * A cache is used by its owning thread only and is therefore
+		 * accessed without holding '_mutex'. A freed block enters the
+		 * cache of the freeing thread regardless of the thread that
+		 * allocated it. Blocks are exchanged with the shared slabs in
+		 * batches of half the cache limit, which also returns cached
+		 * memory once a thread frees more blocks than it allocates.
+		 */
+		struct Thread_cache
+		{
+			struct Block { Block *next; };
+
+			Thread   *owner = nullptr;
+			Block    *blocks[NUM_SLABS] { };
+			unsigned  count [NUM_SLABS] { };
+		};
+
+		/*
+		 * The caches form an open-addressing hash table keyed by the
+		 * owning thread. Owners are assigned with '_mutex' held. A cache
+		 * released at thread exit is marked as 'RELEASED' rather than
+		 * empty to keep the probing sequences of other threads intact.
+		 */
+		Thread_cache _thread_caches[NUM_THREAD_CACHES];
+
+		bool const _use_thread_caches;
+
+		static Thread *_released() { return (Thread *)~0UL; }
+
+		static unsigned _cache_limit(unsigned slab_index)
+		{
+			unsigned const limit =
+				CACHE_BYTES_PER_SLAB >> (slab_index + SLAB_START);
+
+			return max(limit, (unsigned)MIN_CACHED_PER_SLAB);
+		}
+
+		static unsigned _cache_hash(Thread const *thread)
+		{
+			addr_t const key = (addr_t)thread;
+			return (unsigned)((key >> 12) ^ (key >> 20)) % NUM_THREAD_CACHES;
+		}
+
+		/**
+		 * Return cache of calling thread, or nullptr if no cache is usable
+		 */
+		Thread_cache *_thread_cache()
+		{
+			if (!_use_thread_caches)
+				return nullptr;
+
+			Thread * const myself = Thread::myself();
+			if (!myself)
+				return nullptr;
+
+			unsigned const start = _cache_hash(myself);
+			for (unsigned i = 0; i < NUM_THREAD_CACHES; i++) {
+
+				Thread_cache &cache = _thread_caches[(start + i) % NUM_THREAD_CACHES];
+
+				if (cache.owner == myself)
+					return &cache;
+
+				if (!cache.owner)
+					break;
+			}
+
+			return _claim_thread_cache(myself, start);
+		}
+
+		Thread_cache *_claim_thread_cache(Thread *myself, unsigned start)
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (unsigned i = 0; i < NUM_THREAD_CACHES; i++) {
+
+				Thread_cache &cache = _thread_caches[(start + i) % NUM_THREAD_CACHES];
+
+				if (!cache.owner || cache.owner == _released()) {
+					cache.owner = myself;
+					return &cache;
+				}
+			}
+
+			/* all caches are in use, resort to the shared slabs */
+			return nullptr;
+		}
+
+		/**
+		 * Move up to 'num' blocks from the shared slab to the cache
+		 *
+		 * Must be called with '_mutex' held.
+		 */
+		void _refill(Thread_cache &cache, unsigned i, unsigned num)
+		{
+			for (; num; num--) {
+				Thread_cache::Block * const block =
+					(Thread_cache::Block *)_slabs[i]->alloc();
+				if (!block)
+					return;
+
+				block->next = cache.blocks[i];
+				cache.blocks[i] = block;
+				cache.count[i]++;
+			}
+		}
+
+		/**
+		 * Move up to 'num' blocks from the cache to the shared slab
+		 *
+		 * Must be called with '_mutex' held.
+		 */
+		void _drain(Thread_cache &cache, unsigned i, unsigned num)
+		{
+			for (; num && cache.blocks[i]; num--) {
+				Thread_cache::Block * const block = cache.blocks[i];
+				cache.blocks[i] = block->next;
+				cache.count[i]--;
+				_slabs[i]->free(block);
+			}
+		}
+
+		void _drain_all(Thread_cache &cache)
+		{
+			for (unsigned i = 0; i < NUM_SLABS; i++)
+				_drain(cache, i, cache.count[i]);
+		}
+
+		void *_alloc_slab_block(unsigned i)
+		{
+			Thread_cache * const cache = _thread_cache();
+
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				return _slabs[i]->alloc();
+			}
+
+			if (!cache->blocks[i]) {
+				Mutex::Guard guard(_mutex);
+				_refill(*cache, i, _cache_limit(i)/2);
+			}
+
+			Thread_cache::Block * const block = cache->blocks[i];
+			if (!block)
+				return nullptr;
+
+			cache->blocks[i] = block->next;
+			cache->count[i]--;
+			return block;
+		}
+
+		void _free_slab_block(unsigned i, void *addr)
+		{
+			Thread_cache * const cache = _thread_cache();
+
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				_slabs[i]->free(addr);
+				return;
+			}
+
+			Thread_cache::Block * const block = (Thread_cache::Block *)addr;
+			block->next = cache->blocks[i];
+			cache->blocks[i] = block;
+			cache->count[i]++;
+
+			/* return half of the cached blocks if the cache overflows */
+			unsigned const limit = _cache_limit(i);
+			if (cache->count[i] > limit) {
+				Mutex::Guard guard(_mutex);
+				_drain(*cache, i, limit/2);
+			}
+		}
+
 		unsigned _slab_log2(size_t size) const
 		{
 			unsigned msb = Genode::log2(size);
@@ -144,7 +327,9 @@ class Libc::Malloc
 
 	public:
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+		Malloc(Allocator &backing_store, bool use_thread_caches)
+		:
+			_backing_store(backing_store), _use_thread_caches(use_thread_caches)
 		{
 			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
 				_slabs[i - SLAB_START].construct(1U << i, backing_store);
@@ -158,18 +343,18 @@ class Libc::Malloc
 
 		void * alloc(size_t size, size_t align = DEFAULT_ALIGN)
 		{
-			Mutex::Guard guard(_mutex);
-
 			size_t   const real_size = size + _room(align);
 			unsigned const msb       = _slab_log2(real_size);
 
 			void *alloc_addr = nullptr;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			if (msb > SLAB_STOP) {
+				Mutex::Guard guard(_mutex);
 				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _slabs[msb - SLAB_START]->alloc();
+			} else {
+				alloc_addr = _alloc_slab_block(msb - SLAB_START);
+			}
 
 			if (!alloc_addr) return nullptr;
 
@@ -209,8 +394,6 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
-			Mutex::Guard lock_guard(_mutex);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
 			size_t   const  real_size  = md->size;
@@ -219,9 +402,50 @@ class Libc::Malloc
 			void *alloc_addr = (void *)((addr_t)ptr - md->offset);
 
 			if (msb > SLAB_STOP) {
+				Mutex::Guard lock_guard(_mutex);
 				_backing_store.free(alloc_addr, real_size);
 			} else {
-				_slabs[msb - SLAB_START]->free(alloc_addr);
+				_free_slab_block(msb - SLAB_START, alloc_addr);
+			}
+		}
+
+		bool use_thread_caches() const { return _use_thread_caches; }
+
+		/**
+		 * Return the cached blocks of the calling thread to the slabs
+		 *
+		 * Called by a thread when exiting.
+		 */
+		void release_thread_cache()
+		{
+			if (!_use_thread_caches)
+				return;
+
+			Thread * const myself = Thread::myself();
+
+			Mutex::Guard guard(_mutex);
+
+			for (Thread_cache &cache : _thread_caches) {
+				if (myself && cache.owner == myself) {
+					_drain_all(cache);
+					cache.owner = _released();
+				}
+			}
+		}
+
+		/**
+		 * Return the blocks of all caches to the slabs
+		 *
+		 * Used after cloning the allocator state into a forked process,
+		 * which solely contains the forking thread.
+		 */
+		void reset_thread_caches()
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (Thread_cache &cache : _thread_caches) {
+				_drain_all(cache);
+				cache.owner = nullptr;
 			}
 		}
 };
@@ -284,12 +508,12 @@ static Genode::Constructible<Malloc> &constructible_malloc()
 }
 
 
-void Libc::init_malloc(Genode::Allocator &heap)
+void Libc::init_malloc(Genode::Allocator &heap, bool thread_caches)
 {
 
 	Constructible<Malloc> &_malloc = constructible_malloc();
 
-	_malloc.construct(heap);
+	_malloc.construct(heap, thread_caches);
 
 	mallocator = _malloc.operator->();
 }
@@ -300,6 +524,8 @@ void Libc::init_malloc_cloned(Clone_connection &clone_connection)
 	clone_connection.object_content(constructible_malloc());
 
 	mallocator = constructible_malloc().operator->();
+
+	mallocator->reset_thread_caches();
 }
 
 
@@ -307,5 +533,14 @@ void Libc::reinit_malloc(Genode::Allocator &heap)
 {
 	Malloc &malloc = *constructible_malloc();
 
-	construct_at<Malloc>(&malloc, heap);
+	bool const thread_caches = malloc.use_thread_caches();
+
+	construct_at<Malloc>(&malloc, heap, thread_caches);
+}
+
+
+void Libc::release_malloc_thread_cache()
+{
+	if (mallocator)
+		mallocator->release_thread_cache();
 }
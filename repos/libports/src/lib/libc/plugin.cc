@@ -149,6 +149,12 @@ bool Plugin::supports_mmap()
 }
 
 
+bool Plugin::supports_kqueue()
+{
+	return false;
+}
+
+
 /**
  * Generate dummy member function of Plugin class
  */
@@ -198,6 +204,14 @@ DUMMY(int,     -1, shutdown,      (File_descriptor *, int));
 DUMMY(ssize_t, -1, write,         (File_descriptor *, const void *, ::size_t));
 
 
+/*
+ * Readiness interface
+ */
+DUMMY(bool, false, read_ready,  (File_descriptor *));
+DUMMY(bool, false, write_ready, (File_descriptor *));
+DUMMY(Vfs::Vfs_handle *, nullptr, readiness_handle, (File_descriptor *, bool));
+
+
 /*
  * Misc
  */
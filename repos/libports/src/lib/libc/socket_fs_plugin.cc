@@ -265,6 +265,18 @@ struct Libc::Socket_fs::Context : Plugin_context
 			return true;
 		}
 
+		/**
+		 * Return VFS-backed file descriptor that signals readiness changes
+		 */
+		File_descriptor *readiness_fd(bool write)
+		{
+			if (write)
+				return (_state == CONNECTING) ? _fd[Fd::CONNECT].file : nullptr;
+
+			return (_state == ACCEPT_ONLY) ? _fd[Fd::ACCEPT].file
+			                               : _fd[Fd::DATA].file;
+		}
+
 		/*
 		 * Read the connect status from the connect file and return 0 if connected
 		 * or -1 with errno set to the error code.
@@ -335,6 +347,7 @@ struct Libc::Socket_fs::Plugin : Libc::Plugin
 {
 	bool supports_poll() override { return true; }
 	bool supports_select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
+	bool supports_kqueue() override { return true; }
 
 	ssize_t read(File_descriptor *, void *, ::size_t) override;
 	ssize_t write(File_descriptor *, const void *, ::size_t) override;
@@ -343,6 +356,9 @@ struct Libc::Socket_fs::Plugin : Libc::Plugin
 	bool poll(File_descriptor &fd, struct pollfd &pfd) override;
 	int select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
 	int ioctl(File_descriptor *, unsigned long, char *) override;
+	bool read_ready(File_descriptor *) override;
+	bool write_ready(File_descriptor *) override;
+	Vfs::Vfs_handle *readiness_handle(File_descriptor *, bool) override;
 };
 
 
@@ -1297,6 +1313,38 @@ int Socket_fs::Plugin::select(int nfds,
 }
 
 
+bool Socket_fs::Plugin::read_ready(File_descriptor *fd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return false;
+
+	try { return context->read_ready(); }
+	catch (Socket_fs::Context::Inaccessible) { return false; }
+}
+
+
+bool Socket_fs::Plugin::write_ready(File_descriptor *fd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return false;
+
+	try { return context->write_ready(); }
+	catch (Socket_fs::Context::Inaccessible) { return false; }
+}
+
+
+Vfs::Vfs_handle *Socket_fs::Plugin::readiness_handle(File_descriptor *fd, bool write)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return nullptr;
+
+	File_descriptor *socket_fd = context->readiness_fd(write);
+	if (!socket_fd || !socket_fd->plugin) return nullptr;
+
+	return socket_fd->plugin->readiness_handle(socket_fd, false);
+}
+
+
 int Socket_fs::Plugin::close(File_descriptor *fd)
 {
 	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
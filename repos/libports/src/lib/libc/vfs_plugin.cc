@@ -2072,6 +2072,32 @@ int Libc::Vfs_plugin::pipe(Libc::File_descriptor *pipefdo[2])
 }
 
 
+bool Libc::Vfs_plugin::read_ready(File_descriptor *fd)
+{
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+	if (!handle) return false;
+
+	if (handle->fs().read_ready(handle))
+		return true;
+
+	handle->fs().notify_read_ready(handle);
+	return false;
+}
+
+
+bool Libc::Vfs_plugin::write_ready(File_descriptor *)
+{
+	/* XXX always writeable, consistent with 'select' */
+	return true;
+}
+
+
+Vfs::Vfs_handle *Libc::Vfs_plugin::readiness_handle(File_descriptor *fd, bool)
+{
+	return vfs_handle(fd);
+}
+
+
 bool Libc::Vfs_plugin::poll(File_descriptor &fd, struct pollfd &pfd)
 {
 	error("Plugin::poll() is deprecated");
@@ -999,17 +999,29 @@ class Lwip::Udp_socket_dir final :
 			case Lwip_file_handle::DATA: {
 				if (ip_addr_isany(&_to_addr)) break;
 
+				/*
+				 * The pbuf references the data of the caller instead of
+				 * holding a copy. The data is copied only once into the
+				 * packet-stream buffer of the NIC session. Should the
+				 * packet be queued, e.g., during address resolution, lwIP
+				 * copies referenced pbufs on its own.
+				 */
 				file_size remain = count;
 				while (remain) {
-					pbuf *buf = pbuf_alloc(PBUF_RAW, remain, PBUF_RAM);
-					pbuf_take(buf, src, buf->tot_len);
+					u16_t const len = (u16_t)min(remain, (file_size)0xffffU);
+
+					pbuf *buf = pbuf_alloc(PBUF_RAW, len, PBUF_REF);
+					if (!buf)
+						return Write_result::WRITE_ERR_IO;
+
+					buf->payload = const_cast<char *>(src);
 
 					err_t err = udp_sendto(_pcb, buf, &_to_addr, _to_port);
 					pbuf_free(buf);
 					if (err != ERR_OK)
 						return Write_result::WRITE_ERR_IO;
-					remain -= buf->tot_len;
-					src += buf->tot_len;
+					remain -= len;
+					src    += len;
 				}
 				out_count = count;
 				return Write_result::WRITE_OK;
@@ -1118,8 +1130,53 @@ class Lwip::Tcp_socket_dir final :
 		tcp_pcb             *_pcb;
 
 		/* queue of received data */
-		pbuf *_recv_pbuf = nullptr;
-		u16_t _recv_off  = 0;
+		pbuf  *_recv_pbuf = nullptr;
+		size_t _recv_off  = 0;
+
+		/**
+		 * Copy received data to 'dst' and optionally consume it
+		 *
+		 * The pbufs of the queue refer to the packet-stream buffer of the
+		 * NIC session. Each contiguous payload span is copied at once and,
+		 * when consuming, released as soon as it is drained. In contrast
+		 * to 'pbuf_copy_partial', the amount of data is not limited to
+		 * 64 KiB per call.
+		 */
+		file_size _copy_received(char *dst, file_size count, bool consume)
+		{
+			file_size n   = 0;
+			pbuf     *p   = _recv_pbuf;
+			size_t    off = _recv_off;
+
+			while (p && n < count) {
+				size_t const len = min((size_t)(p->len - off), (size_t)(count - n));
+
+				Genode::memcpy(dst + n, (char const *)p->payload + off, len);
+				n   += len;
+				off += len;
+
+				if (off < p->len)
+					break;
+
+				off = 0;
+				if (!consume) {
+					p = p->next;
+					continue;
+				}
+
+				/* keep the remaining chain when freeing the drained head */
+				p = _recv_pbuf->next;
+				if (p)
+					pbuf_ref(p);
+				pbuf_free(_recv_pbuf);
+				_recv_pbuf = p;
+			}
+
+			if (consume)
+				_recv_off = off;
+
+			return n;
+		}
 
 		Open_result _accept_new_socket(Vfs::File_system &fs,
                                        Genode::Allocator &alloc,
@@ -1325,28 +1382,14 @@ class Lwip::Tcp_socket_dir final :
 							: Read_result::READ_OK;
 					}
 
-					u16_t const ucount = count;
-					u16_t const n = pbuf_copy_partial(_recv_pbuf, dst, ucount, _recv_off);
-					_recv_off += n;
-					{
-						u16_t new_off;
-						pbuf *new_head = pbuf_skip(_recv_pbuf, _recv_off, &new_off);
-						if (new_head != NULL && new_head != _recv_pbuf) {
-							/* increment the references on the new head */
-							pbuf_ref(new_head);
-							/* free the buffers chained to the old head */
-							pbuf_free(_recv_pbuf);
-						}
-
-						if (!new_head)
-							pbuf_free(_recv_pbuf);
-						_recv_pbuf = new_head;
-						_recv_off = new_off;
-					}
+					file_size const n = _copy_received(dst, count, true);
 
 					/* ACK the remote */
-					if (_pcb)
-						tcp_recved(_pcb, n);
+					for (file_size acked = 0; _pcb && acked < n; ) {
+						u16_t const len = (u16_t)min(n - acked, (file_size)0xffffU);
+						tcp_recved(_pcb, len);
+						acked += len;
+					}
 
 					if (state == CLOSING)
 						shutdown();
@@ -1357,11 +1400,8 @@ class Lwip::Tcp_socket_dir final :
 				break;
 
 			case Lwip_file_handle::PEEK:
-				if (_recv_pbuf != nullptr) {
-					u16_t const ucount = count;
-					u16_t const n = pbuf_copy_partial(_recv_pbuf, dst, ucount, _recv_off);
-					out_count = n;
-				}
+				if (_recv_pbuf != nullptr)
+					out_count = _copy_received(dst, count, false);
 				return Read_result::READ_OK;
 
 			case Lwip_file_handle::REMOTE:
@@ -0,0 +1,252 @@
+/*
+ * \brief  Test and benchmark of kqueue() and kevent() in libc
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test registers the read ends of many pipes and wakes up one pipe at a
+ * time. The benchmark compares the latency of 'select' and 'kevent' with the
+ * number of watched pipes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/event.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+
+enum { MAX_PIPES = 400, ROUNDS = 2000 };
+
+static int pipes[MAX_PIPES][2];
+
+
+static void fail(char const *msg)
+{
+	fprintf(stderr, "Error: %s (errno=%d)\n", msg, errno);
+	exit(1);
+}
+
+
+static uint64_t now_us()
+{
+	struct timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + ts.tv_nsec/1000;
+}
+
+
+static void write_byte(int i)
+{
+	char c = (char)i;
+	if (write(pipes[i][1], &c, 1) != 1)
+		fail("write to pipe failed");
+}
+
+
+static void read_byte(int i)
+{
+	char c = 0;
+	if (read(pipes[i][0], &c, 1) != 1 || c != (char)i)
+		fail("read from pipe failed");
+}
+
+
+static int kevent_wait(int kq, struct kevent &ev, struct timespec const *timeout)
+{
+	return kevent(kq, nullptr, 0, &ev, 1, timeout);
+}
+
+
+static void register_pipes(int kq, int num, unsigned short flags)
+{
+	for (int i = 0; i < num; i++) {
+		struct kevent change { };
+		EV_SET(&change, pipes[i][0], EVFILT_READ, EV_ADD | flags, 0, 0,
+		       (void *)(intptr_t)i);
+		if (kevent(kq, &change, 1, nullptr, 0, nullptr) != 0)
+			fail("registration of pipe failed");
+	}
+}
+
+
+static void expect_event(int kq, int i, char const *msg)
+{
+	struct timespec const timeout { 1, 0 };
+	struct kevent ev { };
+
+	if (kevent_wait(kq, ev, &timeout) != 1 || (intptr_t)ev.udata != i
+	 || (int)ev.ident != pipes[i][0] || ev.filter != EVFILT_READ)
+		fail(msg);
+}
+
+
+static void expect_no_event(int kq, char const *msg)
+{
+	struct timespec const zero { 0, 0 };
+	struct kevent ev { };
+
+	if (kevent_wait(kq, ev, &zero) != 0)
+		fail(msg);
+}
+
+
+static void change(int kq, int i, unsigned short flags)
+{
+	struct kevent ev { };
+	EV_SET(&ev, pipes[i][0], EVFILT_READ, flags, 0, 0, (void *)(intptr_t)i);
+	if (kevent(kq, &ev, 1, nullptr, 0, nullptr) != 0)
+		fail("modification of event failed");
+}
+
+
+static void test_semantics()
+{
+	int const kq = kqueue();
+	if (kq < 0) fail("kqueue failed");
+
+	register_pipes(kq, MAX_PIPES, 0);
+
+	expect_no_event(kq, "event reported for empty pipes");
+
+	/* level triggered, reported until the data is consumed */
+	write_byte(123);
+	expect_event(kq, 123, "missing level-triggered event");
+	expect_event(kq, 123, "level-triggered event not reported again");
+	read_byte(123);
+	expect_no_event(kq, "event reported for consumed data");
+
+	/* edge triggered, reported on the arrival of data */
+	change(kq, 7, EV_ADD | EV_CLEAR);
+	write_byte(7);
+	expect_event(kq, 7, "missing edge-triggered event");
+	read_byte(7);
+	write_byte(7);
+	expect_event(kq, 7, "missing edge-triggered event for new data");
+	read_byte(7);
+
+	/* disabled events are not reported */
+	change(kq, 8, EV_DISABLE);
+	write_byte(8);
+	expect_no_event(kq, "event reported for disabled filter");
+	change(kq, 8, EV_ENABLE);
+	expect_event(kq, 8, "missing event of re-enabled filter");
+	read_byte(8);
+
+	/* one-shot events vanish after being reported */
+	change(kq, 9, EV_ADD | EV_ONESHOT);
+	write_byte(9);
+	expect_event(kq, 9, "missing one-shot event");
+	struct kevent ev { };
+	EV_SET(&ev, pipes[9][0], EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+	if (kevent(kq, &ev, 1, nullptr, 0, nullptr) != -1 || errno != ENOENT)
+		fail("one-shot event not removed");
+	read_byte(9);
+
+	/* errors are reported as events if there is space */
+	struct timespec const zero { 0, 0 };
+	EV_SET(&ev, 1000, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+	if (kevent(kq, &ev, 1, &ev, 1, &zero) != 1
+	 || !(ev.flags & EV_ERROR) || ev.data != EBADF)
+		fail("missing error event for invalid file descriptor");
+
+	/* timeout */
+	struct timespec const short_timeout { 0, 10*1000*1000 };
+	uint64_t const start_us = now_us();
+	if (kevent_wait(kq, ev, &short_timeout) != 0)
+		fail("event reported for empty pipes");
+	if (now_us() - start_us < 10*1000)
+		fail("timeout expired too early");
+
+	close(kq);
+
+	printf("semantics test succeeded\n");
+}
+
+
+static void benchmark(int num_pipes)
+{
+	unsigned seed = 1;
+	auto next = [&] () { seed = seed*1103515245 + 12345; return (int)((seed >> 16) % num_pipes); };
+
+	/* select */
+	uint64_t const select_start_us = now_us();
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		int const i = next();
+		write_byte(i);
+
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		int nfds = 0;
+		for (int j = 0; j < num_pipes; j++) {
+			FD_SET(pipes[j][0], &readfds);
+			if (pipes[j][0] >= nfds) nfds = pipes[j][0] + 1;
+		}
+
+		if (select(nfds, &readfds, nullptr, nullptr, nullptr) != 1
+		 || !FD_ISSET(pipes[i][0], &readfds))
+			fail("select reported unexpected result");
+
+		read_byte(i);
+	}
+	uint64_t const select_us = now_us() - select_start_us;
+
+	/* kevent */
+	int const kq = kqueue();
+	if (kq < 0) fail("kqueue failed");
+
+	register_pipes(kq, num_pipes, 0);
+
+	uint64_t const kevent_start_us = now_us();
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		int const i = next();
+		write_byte(i);
+
+		struct kevent ev { };
+		if (kevent_wait(kq, ev, nullptr) != 1 || (intptr_t)ev.udata != i)
+			fail("kevent reported unexpected result");
+
+		read_byte(i);
+	}
+	uint64_t const kevent_us = now_us() - kevent_start_us;
+
+	close(kq);
+
+	printf("%3d pipes: select %5llu ns/event, kevent %5llu ns/event\n",
+	       num_pipes,
+	       (unsigned long long)(select_us*1000/ROUNDS),
+	       (unsigned long long)(kevent_us*1000/ROUNDS));
+}
+
+
+int main(int, char **)
+{
+	printf("--- kqueue test ---\n");
+
+	for (int i = 0; i < MAX_PIPES; i++)
+		if (pipe(pipes[i]) != 0)
+			fail("pipe creation failed");
+
+	test_semantics();
+
+	static int const num_pipes[] = { 8, 32, 128, MAX_PIPES };
+	for (int n : num_pipes)
+		benchmark(n);
+
+	printf("--- kqueue test finished ---\n");
+	return 0;
+}
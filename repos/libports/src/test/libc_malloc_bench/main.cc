@@ -0,0 +1,164 @@
+/*
+ * \brief  Benchmark for concurrent malloc/free in the libc
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Each test runs a number of threads concurrently. In the 'local' test, each
+ * thread allocates and frees blocks of pseudo-random size on its own. In the
+ * 'remote' test, threads are paired as producer and consumer, where the
+ * consumer frees the blocks allocated by the producer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+enum {
+	MAX_THREADS = 8,
+	ITERATIONS  = 200000,
+	BATCH       = 64,
+	RING_SIZE   = 256,
+	MAX_SIZE    = 1024,
+};
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec*1000*1000 + ts.tv_nsec/1000;
+}
+
+
+static size_t random_size(unsigned &seed)
+{
+	seed = seed*1103515245 + 12345;
+	return 16 + (seed >> 8) % (MAX_SIZE - 16);
+}
+
+
+/*
+ * Single-producer single-consumer ring of pointers
+ */
+struct Ring
+{
+	void * volatile slots[RING_SIZE];
+
+	unsigned head = 0; /* written by producer */
+	unsigned tail = 0; /* written by consumer */
+
+	void put(void *ptr)
+	{
+		while (__atomic_load_n(&head, __ATOMIC_ACQUIRE)
+		     - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == RING_SIZE)
+			sched_yield();
+
+		slots[head % RING_SIZE] = ptr;
+		__atomic_store_n(&head, head + 1, __ATOMIC_RELEASE);
+	}
+
+	void *get()
+	{
+		while (__atomic_load_n(&head, __ATOMIC_ACQUIRE) == tail)
+			sched_yield();
+
+		void *ptr = slots[tail % RING_SIZE];
+		__atomic_store_n(&tail, tail + 1, __ATOMIC_RELEASE);
+		return ptr;
+	}
+};
+
+
+struct Worker
+{
+	pthread_t  thread;
+	unsigned   seed;
+	Ring      *ring;
+	bool       producer;
+};
+
+
+static void *local_entry(void *arg)
+{
+	Worker &w = *(Worker *)arg;
+
+	void *blocks[BATCH];
+
+	for (unsigned i = 0; i < ITERATIONS/BATCH; i++) {
+		for (unsigned j = 0; j < BATCH; j++)
+			blocks[j] = malloc(random_size(w.seed));
+		for (unsigned j = 0; j < BATCH; j++)
+			free(blocks[j]);
+	}
+	return nullptr;
+}
+
+
+static void *remote_entry(void *arg)
+{
+	Worker &w = *(Worker *)arg;
+
+	for (unsigned i = 0; i < ITERATIONS; i++) {
+		if (w.producer)
+			w.ring->put(malloc(random_size(w.seed)));
+		else
+			free(w.ring->get());
+	}
+	return nullptr;
+}
+
+
+static void run(char const *name, void *(*entry)(void *), unsigned num_threads,
+                unsigned pairs_per_thread)
+{
+	static Worker workers[MAX_THREADS];
+	static Ring   rings[MAX_THREADS/2];
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		rings[i/2]  = Ring { };
+		workers[i]  = Worker { pthread_t(), i + 1, &rings[i/2], (i % 2) == 0 };
+	}
+
+	unsigned long long const start = now_us();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		if (pthread_create(&workers[i].thread, nullptr, entry, &workers[i])) {
+			printf("Error: pthread_create failed\n");
+			exit(-1);
+		}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(workers[i].thread, nullptr);
+
+	unsigned long long const duration_us = now_us() - start;
+	unsigned long long const ops = (unsigned long long)num_threads*pairs_per_thread;
+
+	printf("%s threads=%u: %llu malloc/free pairs in %llu ms (%llu pairs/ms)\n",
+	       name, num_threads, ops, duration_us/1000,
+	       duration_us ? ops*1000/duration_us : 0);
+}
+
+
+int main(int, char **)
+{
+	printf("--- libc malloc benchmark ---\n");
+
+	for (unsigned n = 1; n <= MAX_THREADS; n *= 2)
+		run("local ", local_entry, n, ITERATIONS);
+
+	for (unsigned n = 2; n <= MAX_THREADS; n *= 2)
+		run("remote", remote_entry, n, ITERATIONS/2);
+
+	printf("--- libc malloc benchmark finished ---\n");
+	return 0;
+}
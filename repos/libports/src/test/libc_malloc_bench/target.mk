@@ -0,0 +1,5 @@
+TARGET = test-libc_malloc_bench
+SRC_CC = main.cc
+LIBS   = posix
+
+CC_CXX_WARN_STRICT =
@@ -0,0 +1,114 @@
+/*
+ * \brief  Benchmark of the pipe throughput
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * A writer thread streams data through a pipe to the main thread, using
+ * different sizes of write and read operations. The buffer size of the pipe
+ * is determined by the configuration of the VFS pipe plugin. The optional
+ * first argument is a label printed along with the results.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+
+enum { TOTAL_SIZE = 64*1024*1024, MAX_CHUNK_SIZE = 64*1024 };
+
+static char write_buf[MAX_CHUNK_SIZE];
+static char read_buf[MAX_CHUNK_SIZE];
+
+static int pipefd[2];
+
+static size_t chunk_size;
+
+
+static void *write_pipe(void *)
+{
+	for (size_t total = 0; total < TOTAL_SIZE; ) {
+
+		ssize_t res = write(pipefd[1], write_buf, chunk_size);
+
+		if (res < 0) {
+			fprintf(stderr, "Error writing to pipe\n");
+			exit(1);
+		}
+
+		total += res;
+	}
+	return 0;
+}
+
+
+static unsigned long long now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+
+static void bench(char const *label, size_t size)
+{
+	chunk_size = size;
+
+	unsigned long long const start_us = now_us();
+
+	pthread_t tid;
+	pthread_create(&tid, 0, write_pipe, 0);
+
+	for (size_t total = 0; total < TOTAL_SIZE; ) {
+
+		ssize_t res = read(pipefd[0], read_buf, chunk_size);
+
+		if (res <= 0) {
+			fprintf(stderr, "Error reading from pipe\n");
+			exit(1);
+		}
+
+		total += res;
+	}
+
+	pthread_join(tid, NULL);
+
+	unsigned long long const us = now_us() - start_us;
+
+	printf("%s: chunks of %zu bytes: %llu KiB/s\n", label, size,
+	       us ? (unsigned long long)TOTAL_SIZE*1000000/1024/us : 0);
+}
+
+
+int main(int argc, char *argv[])
+{
+	char const *label = argc > 1 ? argv[1] : "pipe";
+
+	memset(write_buf, 0x55, sizeof(write_buf));
+
+	if (pipe(pipefd) != 0) {
+		fprintf(stderr, "Error creating pipe\n");
+		exit(1);
+	}
+
+	size_t const sizes[] = { 512, 4096, 16*1024, MAX_CHUNK_SIZE };
+
+	for (size_t size : sizes)
+		bench(label, size);
+
+	close(pipefd[0]);
+	close(pipefd[1]);
+
+	printf("--- pipe benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * \brief  TCP throughput benchmark
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The sender transmits a fixed amount of data to the receiver, which reads
+ * the data with different buffer sizes and reports the achieved throughput.
+ * Large buffers benefit from the socket layer handing out long contiguous
+ * spans of received data per read.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+
+enum {
+	PORT        = 2,
+	ROUND_BYTES = 64*1024*1024,
+	MAX_BUFFER  = 1024*1024,
+};
+
+/* buffer sizes used by the receiver, one round per size */
+static size_t const buffer_sizes[] = { 1460, 16*1024, 64*1024, 256*1024, MAX_BUFFER };
+
+enum { NUM_ROUNDS = sizeof(buffer_sizes)/sizeof(buffer_sizes[0]) };
+
+static char buffer[MAX_BUFFER];
+
+
+static void fail(char const *msg)
+{
+	fprintf(stderr, "Error: %s (errno=%d)\n", msg, errno);
+	exit(1);
+}
+
+
+static uint64_t now_us()
+{
+	struct timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + ts.tv_nsec/1000;
+}
+
+
+static void send_all(int sock, size_t total)
+{
+	for (size_t offset = 0; offset < total; ) {
+		size_t  const len = total - offset < sizeof(buffer) ? total - offset : sizeof(buffer);
+		ssize_t const res = send(sock, buffer, len, 0);
+		if (res < 1)
+			fail("send failed");
+		offset += res;
+	}
+}
+
+
+static void recv_all(int sock, size_t total, size_t buffer_size)
+{
+	for (size_t offset = 0; offset < total; ) {
+		size_t  const len = total - offset < buffer_size ? total - offset : buffer_size;
+		ssize_t const res = recv(sock, buffer, len, 0);
+		if (res < 1)
+			fail("recv failed");
+		offset += res;
+	}
+}
+
+
+static int run_sender(char const *host)
+{
+	/* give the receiver some time to start listening */
+	usleep(1000*1000);
+
+	int const sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock < 0) fail("socket failed");
+
+	struct sockaddr_in addr { };
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(host);
+	addr.sin_port        = htons(PORT);
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)))
+		fail("connect failed");
+
+	memset(buffer, 0x55, sizeof(buffer));
+
+	for (unsigned round = 0; round < NUM_ROUNDS; round++)
+		send_all(sock, ROUND_BYTES);
+
+	/* wait until the receiver consumed all data */
+	recv(sock, buffer, 1, 0);
+	close(sock);
+	return 0;
+}
+
+
+static int run_receiver()
+{
+	int const listen_sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (listen_sock < 0) fail("socket failed");
+
+	struct sockaddr_in addr { };
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	addr.sin_port        = htons(PORT);
+
+	if (bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr)))
+		fail("bind failed");
+
+	if (listen(listen_sock, 1))
+		fail("listen failed");
+
+	int const sock = accept(listen_sock, nullptr, nullptr);
+	if (sock < 0) fail("accept failed");
+
+	for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+
+		uint64_t const start_us = now_us();
+		recv_all(sock, ROUND_BYTES, buffer_sizes[round]);
+		uint64_t const duration_us = now_us() - start_us;
+
+		printf("%7zu bytes per read: %4llu MiB/s\n", buffer_sizes[round],
+		       duration_us ? (unsigned long long)
+		                     ((uint64_t)ROUND_BYTES*1000*1000/duration_us/(1024*1024))
+		                   : 0ULL);
+	}
+
+	send(sock, buffer, 1, 0);
+	close(sock);
+	close(listen_sock);
+	return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "recv") == 0) {
+		printf("--- TCP throughput benchmark ---\n");
+		int const result = run_receiver();
+		printf("--- TCP throughput benchmark finished ---\n");
+		return result;
+	}
+
+	if (argc > 2 && strcmp(argv[1], "send") == 0)
+		return run_sender(argv[2]);
+
+	fprintf(stderr, "usage: %s recv | send <host>\n", argv[0]);
+	return 1;
+}
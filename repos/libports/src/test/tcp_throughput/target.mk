@@ -0,0 +1,5 @@
+TARGET = test-tcp_throughput
+SRC_CC = main.cc
+LIBS   = posix
+
+CC_CXX_WARN_STRICT =
@@ -212,6 +212,14 @@ class Block::Driver : Genode::Interface
 		 */
 		virtual void sync() {}
 
+		/**
+		 * Informs the driver that all pending packets were handed over
+		 *
+		 * Note: drivers that merge adjacent requests should override this
+		 *       method and submit the merged requests to the device
+		 */
+		virtual void batch_complete() { }
+
 		/**
 		 * Informs the driver that the client session was closed
 		 *
@@ -0,0 +1,150 @@
+/*
+ * \brief  Batch of adjacent block requests
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Servers that forward client requests to another block device can merge
+ * requests that access adjacent blocks into one large operation. The batch
+ * keeps the original requests for the individual acknowledgement of each
+ * client request after the merged operation completed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BLOCK__REQUEST_BATCH_H_
+#define _INCLUDE__BLOCK__REQUEST_BATCH_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+#include <block/request.h>
+
+namespace Block { template <unsigned> class Request_batch; }
+
+
+template <unsigned MAX_REQUESTS>
+class Block::Request_batch
+{
+	private:
+
+		Request       _requests[MAX_REQUESTS] { };
+		unsigned      _count       = 0;
+		block_count_t _block_count = 0;
+
+		static bool _mergeable(Operation::Type type)
+		{
+			return type == Operation::Type::READ || type == Operation::Type::WRITE;
+		}
+
+	public:
+
+		bool     empty() const { return _count == 0; }
+		bool     full()  const { return _count == MAX_REQUESTS; }
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return array of the requests of the batch in the order of appending
+		 */
+		Request const *requests() const { return _requests; }
+
+		void reset()
+		{
+			_count       = 0;
+			_block_count = 0;
+		}
+
+		/**
+		 * Append request to the batch
+		 *
+		 * Any request is accepted by an empty batch. Otherwise, the request
+		 * must be a read or write of the same type as the batch, starting at
+		 * the block right after the last block of the batch.
+		 *
+		 * \param max_block_count  upper bound of the merged block count
+		 *
+		 * \return true if the request became part of the batch
+		 */
+		bool try_append(Request const &request, block_count_t max_block_count)
+		{
+			if (full())
+				return false;
+
+			Operation const &op = request.operation;
+
+			if (_count) {
+				Operation const &first = _requests[0].operation;
+
+				if (!_mergeable(op.type) || op.type != first.type
+				 || op.block_number != first.block_number + _block_count
+				 || _block_count + op.count > max_block_count)
+					return false;
+			}
+
+			_requests[_count++] = request;
+			_block_count       += op.count;
+			return true;
+		}
+
+		/**
+		 * Return operation that covers all requests of the batch
+		 */
+		Operation operation() const
+		{
+			if (!_count)
+				return Operation { .type         = Operation::Type::INVALID,
+				                   .block_number = 0,
+				                   .count        = 0 };
+
+			Operation op = _requests[0].operation;
+			op.count = _block_count;
+			return op;
+		}
+
+		/**
+		 * Set the result of all requests of the batch
+		 */
+		void succeeded(bool success)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				_requests[i].success = success;
+		}
+
+		/**
+		 * Call 'fn' for each request overlapping a byte range of the batch
+		 *
+		 * \param offset  byte offset relative to the start of the operation
+		 * \param length  size of the range in bytes
+		 *
+		 * The functor is called with the index of the request, the byte
+		 * offset within the payload of the request, and the number of bytes
+		 * as arguments. The parts are visited in ascending order.
+		 */
+		template <typename FN>
+		void for_each_part(Genode::size_t block_size, Genode::size_t offset,
+		                   Genode::size_t length, FN const &fn) const
+		{
+			Genode::size_t pos = 0;
+
+			for (unsigned i = 0; i < _count && length; i++) {
+
+				Genode::size_t const size = _requests[i].operation.count*block_size;
+
+				if (offset < pos + size) {
+					Genode::size_t const request_offset = offset - pos;
+					Genode::size_t const n = Genode::min(length, size - request_offset);
+
+					fn(i, request_offset, n);
+
+					offset += n;
+					length -= n;
+				}
+				pos += size;
+			}
+		}
+};
+
+#endif /* _INCLUDE__BLOCK__REQUEST_BATCH_H_ */
@@ -303,6 +303,49 @@ class Block::Request_stream : Genode::Noncopyable
 			}
 		}
 
+		/**
+		 * Acknowledge a batch of requests as far as possible
+		 *
+		 * \return number of acknowledged requests, which is less than
+		 *         'count' if the acknowledgement queue is congested
+		 *
+		 * The client is not notified before the next call of
+		 * 'wakeup_client_if_needed', which allows a server to complete many
+		 * requests at the cost of a single signal.
+		 */
+		unsigned try_acknowledge(Request const *requests, unsigned count)
+		{
+			typedef Block::Packet_descriptor Packet_descriptor;
+
+			enum { MAX_PACKETS = 32 };
+			Packet_descriptor packets[MAX_PACKETS];
+
+			unsigned acked = 0;
+			while (acked < count) {
+
+				unsigned const num = Genode::min(count - acked, (unsigned)MAX_PACKETS);
+
+				for (unsigned i = 0; i < num; i++) {
+					Request const &request = requests[acked + i];
+
+					Packet_descriptor::Payload
+						payload { .offset = request.offset,
+						          .bytes  = request.operation.count * _info.block_size };
+
+					packets[i] = Packet_descriptor(request.operation, payload,
+					                               request.tag);
+					packets[i].succeeded(request.success);
+				}
+
+				unsigned const n = _tx.sink()->try_ack_packets(packets, num);
+				acked += n;
+
+				if (n < num)
+					break;
+			}
+			return acked;
+		}
+
 		void wakeup_client_if_needed() { _tx.sink()->wakeup(); }
 };
 
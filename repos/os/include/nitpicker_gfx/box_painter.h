@@ -15,12 +15,39 @@
 #define _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 
 #include <os/surface.h>
+#include <nitpicker_gfx/pixel_kernels.h>
 
 
 struct Box_painter
 {
 	typedef Genode::Surface_base::Rect Rect;
 
+	template <typename PT>
+	static inline void _fill_line(PT *dst, int w, PT pix)
+	{
+		for (; w--; dst++)
+			*dst = pix;
+	}
+
+	template <typename PT>
+	static inline void _mix_line(PT *dst, int w, PT pix, int alpha)
+	{
+		for (; w--; dst++)
+			*dst = PT::mix(*dst, pix, alpha);
+	}
+
+	static inline void _fill_line(Genode::Pixel_rgb888 *dst, int w,
+	                              Genode::Pixel_rgb888 pix)
+	{
+		Pixel_kernels::ops().fill(dst, w, pix);
+	}
+
+	static inline void _mix_line(Genode::Pixel_rgb888 *dst, int w,
+	                             Genode::Pixel_rgb888 pix, int alpha)
+	{
+		Pixel_kernels::ops().mix(dst, w, pix, alpha);
+	}
+
 	/**
 	 * Draw filled box
 	 *
@@ -37,19 +64,17 @@ struct Box_painter
 		if (!clipped.valid()) return;
 
 		PT pix(color.r, color.g, color.b);
-		PT *dst, *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
+		PT *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
 
 		int const alpha = color.a;
 
 		if (color.opaque())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = pix;
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				_fill_line(dst_line, clipped.w(), pix);
 
 		else if (!color.transparent())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = PT::mix(*dst, pix, alpha);
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				_mix_line(dst_line, clipped.w(), pix, alpha);
 
 		surface.flush_pixels(clipped);
 	}
@@ -0,0 +1,387 @@
+/*
+ * \brief  Line kernels for compositing 'Pixel_rgb888' pixels
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The painters process most pixels via the kernels below, which operate on
+ * one line of pixels each. Besides the scalar reference implementation,
+ * there are vectorized implementations based on the GCC vector extensions,
+ * which translate to SSE2 on x86_64 and NEON on ARM. On x86_64, an AVX2
+ * variant is used if supported by the CPU and enabled by the kernel. The
+ * results of all implementations are identical to those of the pixel
+ * operations of 'Pixel_rgb888'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NITPICKER_GFX__PIXEL_KERNELS_H_
+#define _INCLUDE__NITPICKER_GFX__PIXEL_KERNELS_H_
+
+#include <os/pixel_rgb888.h>
+
+namespace Pixel_kernels {
+
+	using Genode::uint8_t;
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+	using Genode::Pixel_rgb888;
+
+	struct Ops;
+
+	template <typename, typename, typename> struct Vector;
+
+	typedef uint32_t Uint32x4 __attribute__((vector_size(16)));
+	typedef uint16_t Uint16x8 __attribute__((vector_size(16)));
+	typedef uint8_t  Uint8x4  __attribute__((vector_size(4)));
+	typedef uint8_t  Uint8x8  __attribute__((vector_size(8)));
+	typedef uint32_t Uint32x8 __attribute__((vector_size(32)));
+	typedef uint16_t Uint16x16 __attribute__((vector_size(32)));
+
+	inline Ops const &scalar_ops();
+	inline Ops const *vector_ops();
+	inline Ops const *avx2_ops();
+	inline Ops const &ops();
+}
+
+
+/**
+ * Table of kernel functions
+ */
+struct Pixel_kernels::Ops
+{
+	char const *name;
+
+	/**
+	 * Set 'n' pixels to 'pixel'
+	 */
+	void (*fill)(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel);
+
+	/**
+	 * Mix 'n' pixels with 'pixel' at the ratio 'alpha' (0...256)
+	 */
+	void (*mix)(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha);
+
+	/**
+	 * Blend 'n' pixels of 'src' onto 'dst' according to the 'alpha' values
+	 *
+	 * Pixels with an alpha value of zero are left untouched. Otherwise,
+	 * the pixels are mixed at the ratio 'alpha + 1'.
+	 */
+	void (*blend)(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	              uint8_t const *alpha, unsigned n);
+
+	/**
+	 * Copy 'n' pixels
+	 */
+	void (*copy)(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned n);
+};
+
+
+/**
+ * Vectorized kernels
+ *
+ * A pixel is treated as two 16-bit lanes, one holding blue and green, the
+ * other holding red and the unused byte. This way, all color channels are
+ * weighted by the same 16-bit multiplications as in 'Pixel_rgb888::blend'.
+ *
+ * The functions are always inlined, which lets them adopt the instruction
+ * set of the calling function, e.g., AVX2. Vectors are passed by reference
+ * to keep the calling convention independent from the instruction set.
+ *
+ * \param V32  vector of 32-bit values
+ * \param V16  vector of 16-bit values of the same size
+ * \param V8   vector of 8-bit values with the same number of elements as V32
+ */
+template <typename V32, typename V16, typename V8>
+struct Pixel_kernels::Vector
+{
+	enum { PIXELS = sizeof(V32)/4 };
+
+	#define PIXEL_KERNEL static inline __attribute__((always_inline))
+
+	PIXEL_KERNEL bool _all_zero(V8 const &v)
+	{
+		typedef Genode::uint64_t Word;
+		static_assert(sizeof(V8) <= sizeof(Word), "unexpected vector size");
+
+		Word word = 0;
+		__builtin_memcpy(&word, &v, sizeof(V8));
+		return word == 0;
+	}
+
+	PIXEL_KERNEL void _load(V32 &v, void const *src) {
+		__builtin_memcpy(&v, src, sizeof(V32)); }
+
+	PIXEL_KERNEL void _store(void *dst, V32 const &v) {
+		__builtin_memcpy(dst, &v, sizeof(V32)); }
+
+	/**
+	 * Counterpart of 'Pixel_rgb888::blend' with 'a' holding the weights
+	 */
+	PIXEL_KERNEL void _blend(V16 &res, V32 const &p, V16 const &a)
+	{
+		V16 const rb = (V16)p & 0xff, gx = (V16)p >> 8;
+		res = ((a*gx) & 0xff00) | ((a*rb) >> 8);
+	}
+
+	PIXEL_KERNEL void fill(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel)
+	{
+		V32 const v = (V32){ } + pixel.pixel;
+
+		for (; n >= 2*PIXELS; n -= 2*PIXELS, dst += 2*PIXELS) {
+			_store(dst, v);
+			_store(dst + PIXELS, v);
+		}
+		for (; n >= PIXELS; n -= PIXELS, dst += PIXELS)
+			_store(dst, v);
+
+		for (; n--; dst++)
+			*dst = pixel;
+	}
+
+	PIXEL_KERNEL void mix(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha)
+	{
+		V16 const a  = (V16){ } + (uint16_t)alpha;
+		V16 const na = (V16){ } + (uint16_t)(256 - alpha);
+
+		/* the weighted color is the same for all pixels */
+		V16 weighted;
+		_blend(weighted, (V32){ } + pixel.pixel, a);
+
+		for (; n >= PIXELS; n -= PIXELS, dst += PIXELS) {
+			V32 d;
+			V16 weighted_d;
+			_load(d, dst);
+			_blend(weighted_d, d, na);
+			_store(dst, (V32)(weighted_d + weighted) & 0xffffff);
+		}
+
+		for (; n--; dst++)
+			*dst = Pixel_rgb888::mix(*dst, pixel, alpha);
+	}
+
+	PIXEL_KERNEL void blend(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                        uint8_t const *alpha, unsigned n)
+	{
+		for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS, alpha += PIXELS) {
+
+			V8 a8;
+			__builtin_memcpy(&a8, alpha, sizeof(a8));
+
+			/* skip fully transparent pixels */
+			if (_all_zero(a8))
+				continue;
+
+			V32 const a32 = __builtin_convertvector(a8, V32);
+
+			V32 const keep = (V32)(a32 == 0);
+			V16 const a    = (V16)((a32 + 1) | ((a32 + 1) << 16));
+			V16 const na   = 256 - a;
+
+			V32 d, s;
+			V16 weighted_d, weighted_s;
+			_load(d, dst);
+			_load(s, src);
+			_blend(weighted_d, d, na);
+			_blend(weighted_s, s, a);
+
+			V32 const mixed = (V32)(weighted_d + weighted_s) & 0xffffff;
+			_store(dst, (mixed & ~keep) | (d & keep));
+		}
+
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = Pixel_rgb888::mix(*dst, *src, *alpha + 1);
+	}
+
+	PIXEL_KERNEL void copy(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned n)
+	{
+		for (; n >= 2*PIXELS; n -= 2*PIXELS, dst += 2*PIXELS, src += 2*PIXELS) {
+			V32 v0, v1;
+			_load(v0, src);
+			_load(v1, src + PIXELS);
+			_store(dst, v0);
+			_store(dst + PIXELS, v1);
+		}
+		for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS) {
+			V32 v;
+			_load(v, src);
+			_store(dst, v);
+		}
+
+		for (; n--; )
+			*dst++ = *src++;
+	}
+
+	#undef PIXEL_KERNEL
+};
+
+
+namespace Pixel_kernels {
+
+	namespace Scalar {
+
+		inline void fill(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel)
+		{
+			for (; n--; dst++)
+				*dst = pixel;
+		}
+
+		inline void mix(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha)
+		{
+			for (; n--; dst++)
+				*dst = Pixel_rgb888::mix(*dst, pixel, alpha);
+		}
+
+		inline void blend(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+		                  uint8_t const *alpha, unsigned n)
+		{
+			for (; n--; dst++, src++, alpha++)
+				if (__builtin_expect(*alpha != 0, true))
+					*dst = Pixel_rgb888::mix(*dst, *src, *alpha + 1);
+		}
+
+		inline void copy(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned n)
+		{
+			for (; n--; )
+				*dst++ = *src++;
+		}
+	}
+
+	Ops const &scalar_ops()
+	{
+		static Ops const ops { "scalar", Scalar::fill, Scalar::mix,
+		                       Scalar::blend, Scalar::copy };
+		return ops;
+	}
+
+	/*
+	 * On 32-bit ARM without NEON, the vector extensions would merely be
+	 * emulated by scalar code.
+	 */
+#if defined(__x86_64__) || defined(__aarch64__) || defined(__ARM_NEON)
+
+	namespace Vector_128 {
+
+		typedef Vector<Uint32x4, Uint16x8, Uint8x4> V;
+
+		inline void fill(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel) {
+			V::fill(dst, n, pixel); }
+
+		inline void mix(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha) {
+			V::mix(dst, n, pixel, alpha); }
+
+		inline void blend(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+		                  uint8_t const *alpha, unsigned n) {
+			V::blend(dst, src, alpha, n); }
+
+		inline void copy(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned n) {
+			V::copy(dst, src, n); }
+	}
+
+	Ops const *vector_ops()
+	{
+#if defined(__x86_64__)
+		static Ops const ops { "sse2", Vector_128::fill, Vector_128::mix,
+		                       Vector_128::blend, Vector_128::copy };
+#else
+		static Ops const ops { "neon", Vector_128::fill, Vector_128::mix,
+		                       Vector_128::blend, Vector_128::copy };
+#endif
+		return &ops;
+	}
+
+#else
+
+	Ops const *vector_ops() { return nullptr; }
+
+#endif
+
+#if defined(__x86_64__)
+
+	namespace Avx2 {
+
+		typedef Vector<Uint32x8, Uint16x16, Uint8x8> V;
+
+		#define AVX2 __attribute__((target("avx2")))
+
+		AVX2 inline void fill(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel) {
+			V::fill(dst, n, pixel); }
+
+		AVX2 inline void mix(Pixel_rgb888 *dst, unsigned n, Pixel_rgb888 pixel, int alpha) {
+			V::mix(dst, n, pixel, alpha); }
+
+		AVX2 inline void blend(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+		                       uint8_t const *alpha, unsigned n) {
+			V::blend(dst, src, alpha, n); }
+
+		AVX2 inline void copy(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned n) {
+			V::copy(dst, src, n); }
+
+		#undef AVX2
+
+		/**
+		 * Return true if the CPU supports AVX2 and the kernel saves the
+		 * AVX register state
+		 */
+		inline bool supported()
+		{
+			auto cpuid = [] (unsigned leaf, unsigned &b, unsigned &c) {
+				unsigned a = leaf, d = 0;
+				c = 0;
+				asm volatile ("cpuid" : "+a" (a), "=b" (b), "+c" (c), "=d" (d));
+				return a;
+			};
+
+			unsigned b = 0, c = 0;
+			if (cpuid(0, b, c) < 7)
+				return false;
+
+			/* OSXSAVE and AVX */
+			cpuid(1, b, c);
+			if ((c & (3u << 27)) != (3u << 27))
+				return false;
+
+			/* SSE and AVX state enabled in XCR0 */
+			unsigned xcr0_lo = 0, xcr0_hi = 0;
+			asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+			if ((xcr0_lo & 6) != 6)
+				return false;
+
+			cpuid(7, b, c);
+			return b & (1u << 5);
+		}
+	}
+
+	Ops const *avx2_ops()
+	{
+		static Ops const ops { "avx2", Avx2::fill, Avx2::mix,
+		                       Avx2::blend, Avx2::copy };
+
+		return Avx2::supported() ? &ops : nullptr;
+	}
+
+#else
+
+	Ops const *avx2_ops() { return nullptr; }
+
+#endif
+
+	/**
+	 * Return fastest kernels supported by the CPU
+	 */
+	Ops const &ops()
+	{
+		static Ops const &ops = avx2_ops()   ? *avx2_ops()
+		                      : vector_ops() ? *vector_ops()
+		                      :                scalar_ops();
+		return ops;
+	}
+}
+
+#endif /* _INCLUDE__NITPICKER_GFX__PIXEL_KERNELS_H_ */
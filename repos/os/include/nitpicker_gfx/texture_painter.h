@@ -16,6 +16,7 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <nitpicker_gfx/pixel_kernels.h>
 
 
 struct Texture_painter
@@ -42,6 +43,40 @@ struct Texture_painter
 	typedef Genode::Surface_base::Point Point;
 	typedef Genode::Surface_base::Rect  Rect;
 
+	template <typename PT>
+	static inline void _copy_lines(PT *dst, int dst_w, PT const *src, int src_w,
+	                               int w, int h)
+	{
+		blit(src, src_w*sizeof(PT), dst, dst_w*sizeof(PT), w*sizeof(PT), h);
+	}
+
+	template <typename PT>
+	static inline void _blend_line(PT *dst, PT const *src,
+	                               unsigned char const *alpha, int w)
+	{
+		for (; w--; src++, dst++, alpha++) {
+			unsigned char const alpha_value = *alpha;
+			if (__builtin_expect(alpha_value != 0, true))
+				*dst = PT::mix(*dst, *src, alpha_value + 1);
+		}
+	}
+
+	static inline void _copy_lines(Genode::Pixel_rgb888 *dst, int dst_w,
+	                               Genode::Pixel_rgb888 const *src, int src_w,
+	                               int w, int h)
+	{
+		Pixel_kernels::Ops const &ops = Pixel_kernels::ops();
+		for (; h--; src += src_w, dst += dst_w)
+			ops.copy(dst, src, w);
+	}
+
+	static inline void _blend_line(Genode::Pixel_rgb888 *dst,
+	                               Genode::Pixel_rgb888 const *src,
+	                               unsigned char const *alpha, int w)
+	{
+		Pixel_kernels::ops().blend(dst, src, alpha, w);
+	}
+
 
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT>       &surface,
@@ -77,7 +112,6 @@ struct Texture_painter
 		int i, j;
 		PT            const *s;
 		PT                  *d;
-		unsigned char const *a;
 
 		switch (mode) {
 
@@ -88,9 +122,7 @@ struct Texture_painter
 			 * a plain pixel blit.
 			 */
 			if (texture.alpha() == 0 || !allow_alpha) {
-				blit(src, src_w*sizeof(PT),
-				     dst, dst_w*sizeof(PT),
-				     clipped.w()*sizeof(PT), clipped.h());
+				_copy_lines(dst, dst_w, src, src_w, clipped.w(), clipped.h());
 				break;
 			}
 
@@ -98,11 +130,7 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++) {
-					unsigned char const alpha_value = *a;
-					if (__builtin_expect(alpha_value != 0, true))
-						*d = PT::mix(*d, *s, alpha_value + 1);
-				}
+				_blend_line(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
@@ -61,6 +61,13 @@
  * acknowledge buffers using the methods 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * Packets can also be submitted, obtained, and acknowledged in batches via
+ * 'try_submit_packets', 'try_get_packets', 'try_ack_packets', and
+ * 'try_get_acked_packets'. These methods never block and access each queue
+ * only once per batch. The signal to the other side is deferred to the next
+ * call of 'wakeup' and is omitted if the other side is known to be active,
+ * so that the notification cost is amortized over the batch.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
  */
@@ -81,6 +88,7 @@
 #include <base/allocator.h>
 #include <dataspace/client.h>
 #include <util/string.h>
+#include <util/misc_math.h>
 #include <util/construct_at.h>
 
 namespace Genode {
@@ -211,6 +219,48 @@ class Genode::Packet_descriptor_queue
 			return true;
 		}
 
+		/**
+		 * Place up to 'count' packet descriptors into queue
+		 *
+		 * The head index is updated only once for the whole batch.
+		 *
+		 * \return number of packet descriptors added
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned count)
+		{
+			/* the index is shared with the peer and must not be trusted */
+			unsigned const num  = Genode::min(count, slots_free());
+			unsigned       head = _head%QUEUE_SIZE;
+
+			for (unsigned i = 0; i < num; i++) {
+				_queue[head] = packets[i];
+				head = (head + 1)%QUEUE_SIZE;
+			}
+			_head = head;
+			return num;
+		}
+
+		/**
+		 * Take up to 'max' packet descriptors from queue
+		 *
+		 * The tail index is updated only once for the whole batch.
+		 *
+		 * \return number of packet descriptors taken
+		 */
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned max)
+		{
+			/* the index is shared with the peer and must not be trusted */
+			unsigned const num  = Genode::min(max, count());
+			unsigned       tail = _tail%QUEUE_SIZE;
+
+			for (unsigned i = 0; i < num; i++) {
+				packets[i] = _queue[tail];
+				tail = (tail + 1)%QUEUE_SIZE;
+			}
+			_tail = tail;
+			return num;
+		}
+
 		/**
 		 * Take packet descriptor from queue
 		 *
@@ -255,9 +305,22 @@ class Genode::Packet_descriptor_queue
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free()
+		{
+			unsigned const head = _head%QUEUE_SIZE, tail = _tail%QUEUE_SIZE;
+
+			return ((tail > head) ? tail - head : QUEUE_SIZE - head + tail) - 1;
+		}
+
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned count()
+		{
+			unsigned const head = _head%QUEUE_SIZE, tail = _tail%QUEUE_SIZE;
+
+			return (QUEUE_SIZE + head - tail)%QUEUE_SIZE;
+		}
 };
 
 
@@ -365,6 +428,29 @@ class Genode::Packet_descriptor_transmitter
 			return true;
 		}
 
+		/**
+		 * Put as many of the given packets into the tx queue as possible
+		 *
+		 * The receiver is woken up at most once for the whole batch by a
+		 * subsequent call of 'tx_wakeup'. A wakeup is needed only if the
+		 * receiver may have seen the queue empty, which is the case if the
+		 * queue holds no packets other than those of the batch.
+		 *
+		 * \return number of packets put into the queue
+		 */
+		unsigned try_tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		                unsigned count)
+		{
+			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
+
+			unsigned const num = _tx_queue->add(packets, count);
+
+			if (num && _tx_queue->count() <= num)
+				_tx_wakeup_needed = true;
+
+			return num;
+		}
+
 		bool tx_wakeup()
 		{
 			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
@@ -483,6 +569,29 @@ class Genode::Packet_descriptor_receiver
 			return packet;
 		}
 
+		/**
+		 * Take as many packets as available, up to 'max', from the rx queue
+		 *
+		 * The transmitter is woken up at most once for the whole batch by a
+		 * subsequent call of 'rx_wakeup'. A wakeup is needed only if the
+		 * transmitter may have seen the queue full, which is the case if
+		 * no more slots are free than were freed by the batch.
+		 *
+		 * \return number of packets taken from the queue
+		 */
+		unsigned try_rx(typename RX_QUEUE::Packet_descriptor *packets,
+		                unsigned max)
+		{
+			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
+
+			unsigned const num = _rx_queue->get(packets, max);
+
+			if (num && _rx_queue->slots_free() <= num)
+				_rx_wakeup_needed = true;
+
+			return num;
+		}
+
 		bool rx_wakeup()
 		{
 			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
@@ -811,6 +920,20 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Submit a batch of packets to the sink as far as possible
+		 *
+		 * \return number of submitted packets, which is less than 'count'
+		 *         if the submit queue is congested
+		 *
+		 * This method never blocks. The sink is not notified before the
+		 * next call of 'wakeup', so that a batch costs at most one signal.
+		 */
+		unsigned try_submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _submit_transmitter.try_tx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -848,6 +971,19 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _ack_receiver.try_rx();
 		}
 
+		/**
+		 * Get all available acknowledgements from sink, up to 'max'
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks. The sink is not notified about the
+		 * freed ack-queue slots before the next call of 'wakeup'.
+		 */
+		unsigned try_get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.try_rx(packets, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -971,6 +1107,19 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.try_rx();
 		}
 
+		/**
+		 * Get all available packets from source, up to 'max'
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks. The source is not notified about the
+		 * freed submit-queue slots before the next call of 'wakeup'.
+		 */
+		unsigned try_get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _submit_receiver.try_rx(packets, max);
+		}
+
 		/**
 		 * Wake up the packet source if needed
 		 *
@@ -1035,6 +1184,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets to the client as far as possible
+		 *
+		 * \return number of acknowledged packets, which is less than 'count'
+		 *         if the acknowledgement queue is congested
+		 *
+		 * This method never blocks. The source is not notified before the
+		 * next call of 'wakeup', so that a batch costs at most one signal.
+		 */
+		unsigned try_ack_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _ack_transmitter.try_tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
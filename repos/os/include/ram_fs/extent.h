@@ -0,0 +1,313 @@
+/*
+ * \brief  Extent-based data structure for storing sparse files in RAM
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * In contrast to the fixed-depth 'Chunk_index' hierarchy, file content is
+ * kept in a sorted set of variable-sized extents of contiguous memory.
+ * Sequentially written files are backed by extents of geometrically growing
+ * size. Allocations above the heap's threshold for big allocations are each
+ * backed by a dedicated RAM dataspace. Unwritten ranges (holes) are not
+ * backed by memory and read as zeros.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RAM_FS__EXTENT_H_
+#define _INCLUDE__RAM_FS__EXTENT_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <util/avl_tree.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+#include <base/allocator.h>
+#include <file_system_session/file_system_session.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	class Extent_map;
+}
+
+
+class File_system::Extent_map : Noncopyable
+{
+	public:
+
+		enum {
+			MIN_EXTENT_SIZE = 4*1024,
+			MAX_EXTENT_SIZE = 4*1024*1024,
+		};
+
+	private:
+
+		struct Extent : Avl_node<Extent>
+		{
+			seek_off_t const offset;    /* absolute offset within the file */
+			size_t     const capacity;  /* size of 'data' in bytes */
+			char     * const data;
+
+			/*
+			 * Number of valid bytes at the start of the extent. Bytes
+			 * beyond 'used' are undefined and read as zeros.
+			 */
+			size_t used { 0 };
+
+			Extent(seek_off_t offset, size_t capacity, char *data)
+			: offset(offset), capacity(capacity), data(data) { }
+
+			/*
+			 * Noncopyable
+			 */
+			Extent(Extent const &) = delete;
+			Extent &operator = (Extent const &) = delete;
+
+			seek_off_t end() const { return offset + capacity; }
+
+			bool higher(Extent *e) { return e->offset > offset; }
+		};
+
+		Allocator &_alloc;
+
+		Avl_tree<Extent> _extents { };
+
+		/**
+		 * Return extent with the highest offset not above 'offset'
+		 */
+		Extent *_floor(seek_off_t offset) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = _extents.first(); e; ) {
+				bool const right = (e->offset <= offset);
+				if (right)
+					result = e;
+				e = e->child(right);
+			}
+			return result;
+		}
+
+		/**
+		 * Return extent with the lowest offset above 'offset'
+		 */
+		Extent *_next(seek_off_t offset) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = _extents.first(); e; ) {
+				bool const right = (e->offset <= offset);
+				if (!right)
+					result = e;
+				e = e->child(right);
+			}
+			return result;
+		}
+
+		/**
+		 * Return extent with the highest offset
+		 */
+		Extent *_last() const
+		{
+			Extent *e = _extents.first();
+			while (e && e->child(Extent::RIGHT))
+				e = e->child(Extent::RIGHT);
+			return e;
+		}
+
+		/**
+		 * Allocate extent starting at 'offset', which lies within a hole
+		 *
+		 * \param prev  extent preceding 'offset' or nullptr
+		 * \return      new extent, or nullptr if no memory is left
+		 */
+		Extent *_alloc_extent(seek_off_t offset, size_t len, Extent const *prev)
+		{
+			/* double the size of the extents of sequentially written files */
+			size_t size = MIN_EXTENT_SIZE;
+			if (prev && prev->end() == offset)
+				size = min((size_t)MAX_EXTENT_SIZE, 2*prev->capacity);
+
+			size_t const needed = min((size_t)MAX_EXTENT_SIZE,
+			                          align_addr(len, 12));
+			size = max(size, needed);
+
+			/* never overlap the following extent */
+			if (Extent const *next = _next(offset))
+				size = (size_t)min((seek_off_t)size, next->offset - offset);
+
+			/*
+			 * Extents above the heap's threshold for big allocations are
+			 * backed by a dedicated dataspace, which costs a capability.
+			 */
+			auto try_alloc = [&] (size_t size) -> char *
+			{
+				char *data = nullptr;
+				try { if (_alloc.alloc(size, &data)) return data; }
+				catch (Out_of_ram)  { }
+				catch (Out_of_caps) { }
+				return nullptr;
+			};
+
+			char *data = try_alloc(size);
+
+			/* retry with the smallest possible extent */
+			if (!data && size > MIN_EXTENT_SIZE) {
+				size = MIN_EXTENT_SIZE;
+				data = try_alloc(size);
+			}
+
+			if (!data)
+				return nullptr;
+
+			Extent *extent = nullptr;
+			try { extent = new (_alloc) Extent(offset, size, data); }
+			catch (Out_of_ram)  { }
+			catch (Out_of_caps) { }
+
+			if (!extent) {
+				_alloc.free(data, size);
+				return nullptr;
+			}
+
+			_extents.insert(extent);
+			return extent;
+		}
+
+		void _destroy_extent(Extent &extent)
+		{
+			_extents.remove(&extent);
+			_alloc.free(extent.data, extent.capacity);
+			destroy(_alloc, &extent);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator for extent meta data and content
+		 */
+		Extent_map(Allocator &alloc) : _alloc(alloc) { }
+
+		~Extent_map()
+		{
+			while (Extent *e = _extents.first())
+				_destroy_extent(*e);
+		}
+
+		/**
+		 * Return position after the highest offset that was written to
+		 */
+		file_size_t used_size() const
+		{
+			Extent const *last = _last();
+			return last ? last->offset + last->used : 0;
+		}
+
+		/**
+		 * Write data
+		 *
+		 * \return number of bytes written, which is less than 'len' if
+		 *         memory for the content ran out
+		 */
+		size_t write(char const *src, size_t len, seek_off_t seek_offset)
+		{
+			size_t written = 0;
+
+			while (len > 0) {
+
+				Extent *e = _floor(seek_offset);
+				if (!e || seek_offset >= e->end())
+					e = _alloc_extent(seek_offset, len, e);
+
+				if (!e)
+					break;
+
+				size_t const local_offset = (size_t)(seek_offset - e->offset);
+				size_t const curr_len     = min(len, e->capacity - local_offset);
+
+				/* fill gap between valid bytes and the written range */
+				if (local_offset > e->used)
+					memset(e->data + e->used, 0, local_offset - e->used);
+
+				memcpy(e->data + local_offset, src, curr_len);
+				e->used = max(e->used, local_offset + curr_len);
+
+				len         -= curr_len;
+				src         += curr_len;
+				seek_offset += curr_len;
+				written     += curr_len;
+			}
+			return written;
+		}
+
+		/**
+		 * Read data, holes are filled with zeros
+		 */
+		void read(char *dst, size_t len, seek_off_t seek_offset) const
+		{
+			while (len > 0) {
+
+				Extent const *e = _floor(seek_offset);
+
+				if (e && seek_offset < e->offset + e->used) {
+
+					size_t const local_offset = (size_t)(seek_offset - e->offset);
+					size_t const curr_len     = min(len, e->used - local_offset);
+
+					memcpy(dst, e->data + local_offset, curr_len);
+
+					len         -= curr_len;
+					dst         += curr_len;
+					seek_offset += curr_len;
+					continue;
+				}
+
+				/* hole up to the next extent */
+				size_t curr_len = len;
+				if (Extent const *next = _next(seek_offset))
+					curr_len = (size_t)min((seek_off_t)len, next->offset - seek_offset);
+
+				memset(dst, 0, curr_len);
+
+				len         -= curr_len;
+				dst         += curr_len;
+				seek_offset += curr_len;
+			}
+		}
+
+		/**
+		 * Truncate content to specified size in bytes
+		 *
+		 * Similar to 'Chunk_index::truncate', this function can be used
+		 * to shrink the content only.
+		 */
+		void truncate(file_size_t size)
+		{
+			while (Extent *e = _last()) {
+
+				if (e->offset < size) {
+					e->used = (size_t)min((file_size_t)e->used, size - e->offset);
+					break;
+				}
+				_destroy_extent(*e);
+			}
+		}
+
+		/**
+		 * Return number of extents, used for statistics
+		 */
+		unsigned count() const
+		{
+			unsigned result = 0;
+			_extents.for_each([&] (Extent const &) { result++; });
+			return result;
+		}
+};
+
+#endif /* _INCLUDE__RAM_FS__EXTENT_H_ */
@@ -18,6 +18,9 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+#include <rom_session/rom_session.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -31,6 +34,8 @@ namespace Rom {
 	class Writer;
 	class Reader;
 	class Buffer;
+	class Snapshot;
+	struct Snapshot_resources;
 
 	typedef Genode::List<Module> Module_list;
 	typedef Genode::List<Reader> Reader_list;
@@ -57,6 +62,85 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Resources used for sharing module content among readers
+ */
+struct Rom::Snapshot_resources
+{
+	Genode::Allocator     &alloc;          /* meta data of snapshots */
+	Genode::Rm_connection &rm_connection;  /* read-only views */
+
+	Snapshot_resources(Genode::Allocator &alloc, Genode::Rm_connection &rm)
+	: alloc(alloc), rm_connection(rm) { }
+};
+
+
+/**
+ * Immutable revision of the module content shared by all readers
+ *
+ * Each snapshot is backed by a dedicated dataspace, which is handed out to
+ * the readers as a read-only managed dataspace. A snapshot is freed as soon
+ * as neither the module nor any reader refers to it anymore.
+ */
+class Rom::Snapshot
+{
+	private:
+
+		friend class Module;
+
+		/*
+		 * Noncopyable
+		 */
+		Snapshot(Snapshot const &);
+		Snapshot &operator = (Snapshot const &);
+
+		Genode::Rm_connection &_rm_connection;
+
+		size_t        const _size;
+		unsigned long const _version;
+
+		/* plus zero termination */
+		Attached_ram_dataspace _ds;
+
+		Genode::Region_map_client _rm { _rm_connection.create(_ds.size()) };
+
+		Genode::Dataspace_capability _ro_ds { };
+
+		unsigned _ref_cnt = 0;
+
+		Snapshot(Genode::Ram_allocator &ram, Genode::Region_map &rm,
+		         Genode::Rm_connection &rm_connection,
+		         char const *src, size_t len, unsigned long version)
+		:
+			_rm_connection(rm_connection), _size(len), _version(version),
+			_ds(ram, rm, len + 1)
+		{
+			Genode::memcpy(_ds.local_addr<char>(), src, len);
+			_ds.local_addr<char>()[len] = 0;
+
+			enum { OFFSET = 0, LOCAL_ADDR = false, EXEC = false, WRITE = false };
+			_rm.attach(_ds.cap(), _ds.size(), OFFSET,
+			           LOCAL_ADDR, (Genode::addr_t)~0, EXEC, WRITE);
+			_ro_ds = _rm.dataspace();
+		}
+
+	public:
+
+		~Snapshot() { _rm_connection.destroy(_rm.rpc_cap()); }
+
+		char const *content() const { return _ds.local_addr<char const>(); }
+
+		size_t size() const { return _size; }
+
+		unsigned long version() const { return _version; }
+
+		Genode::Rom_dataspace_capability dataspace() const
+		{
+			return Genode::static_cap_cast<Genode::Rom_dataspace>(_ro_ds);
+		}
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -75,6 +159,18 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Return current snapshot of the module content
+	 *
+	 * The reference obtained by the reader must be released via
+	 * 'release_snapshot'. The return value is nullptr if the module does
+	 * not share its content with readers, or if the reader is not permitted
+	 * to read the content.
+	 */
+	virtual Snapshot *acquire_snapshot(Reader const &) const { return nullptr; }
+
+	virtual void release_snapshot(Snapshot &) const { }
 };
 
 
@@ -164,6 +260,55 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t _size = 0;
 
+		/**
+		 * Resources for sharing the content, or nullptr if each reader
+		 * obtains a private copy
+		 */
+		Snapshot_resources * const _snapshot_resources;
+
+		/**
+		 * Current revision of the content if shared by readers
+		 */
+		Snapshot *_snapshot = nullptr;
+
+		unsigned long _version = 0;
+
+		void _drop(Snapshot &snapshot) const
+		{
+			if (--snapshot._ref_cnt == 0)
+				Genode::destroy(_snapshot_resources->alloc, &snapshot);
+		}
+
+		void _drop_current_snapshot()
+		{
+			if (_snapshot)
+				_drop(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
+		/**
+		 * Replace current snapshot by a new revision of the content
+		 */
+		void _install_snapshot(char const *src, size_t len)
+		{
+			Snapshot &snapshot = *new (_snapshot_resources->alloc)
+				Snapshot(_ram, _rm, _snapshot_resources->rm_connection,
+				         src, len, ++_version);
+
+			_drop_current_snapshot();
+			_snapshot = &snapshot;
+			_snapshot->_ref_cnt++;
+		}
+
+		char const *_content() const
+		{
+			if (_snapshot)
+				return _snapshot->content();
+
+			return _ds.constructed() ? _ds->local_addr<char const>() : nullptr;
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -182,15 +327,19 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 *                      time when the module content is obtained
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
+		 * \param snapshots     if not nullptr, each revision of the content
+		 *                      is kept in a dataspace shared by all readers
 		 */
 		Module(Genode::Ram_allocator &ram,
 		       Genode::Region_map    &rm,
 		       Name            const &name,
 		       Read_policy     const &read_policy,
-		       Write_policy    const &write_policy)
+		       Write_policy    const &write_policy,
+		       Snapshot_resources    *snapshots = nullptr)
 		:
 			_name(name), _ram(ram), _rm(rm),
-			_read_policy(read_policy), _write_policy(write_policy)
+			_read_policy(read_policy), _write_policy(write_policy),
+			_snapshot_resources(snapshots)
 		{ }
 
 
@@ -222,7 +371,13 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
+				if (_ds.constructed())
+					Genode::memset(_ds->local_addr<char>(), 0, _size);
+
+				/* readers of a shared snapshot obtain an empty revision */
+				if (_snapshot)
+					_install_snapshot("", 0);
+
 				_size = 0;
 				_last_writer = nullptr;
 			}
@@ -244,8 +399,24 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			return cnt;
 		}
 
+		/**
+		 * Notify ROM clients that access the module about new content
+		 */
+		void _notify_readers()
+		{
+			for (Reader *r = _readers.first(); r; r = r->next()) {
+
+				if (_read_policy.read_permitted(*this, *_last_writer, *r))
+					r->notify_module_changed();
+				else
+					r->notify_module_invalidated();
+			}
+		}
+
 	public:
 
+		~Module() { _drop_current_snapshot(); }
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -260,6 +431,16 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			_last_writer = &writer;
 
+			if (_snapshot_resources) {
+
+				/* the new revision replaces the current one for future readers */
+				_install_snapshot(src, src_len);
+				_size = src_len;
+
+				_notify_readers();
+				return;
+			}
+
 			/*
 			 * Realloc backing store if needed
 			 *
@@ -277,14 +458,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			/* append zero termination */
 			_ds->local_addr<char>()[src_len] = 0;
 
-			/* notify ROM clients that access the module */
-			for (Reader *r = _readers.first(); r; r = r->next()) {
-
-				if (_read_policy.read_permitted(*this, *_last_writer, *r))
-					r->notify_module_changed();
-				else
-					r->notify_module_invalidated();
-			}
+			_notify_readers();
 		}
 
 		/**
@@ -292,7 +466,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!_content() || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
@@ -301,10 +475,35 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			if (dst_len < _size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
+			Genode::memcpy(dst, _content(), _size);
 			return _size;
 		}
 
+		/**
+		 * Readable_module interface
+		 */
+		Snapshot *acquire_snapshot(Reader const &reader) const override
+		{
+			if (!_snapshot)
+				return nullptr;
+
+			/* a snapshot without writer is empty */
+			if (_last_writer
+			 && !_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			_snapshot->_ref_cnt++;
+			return _snapshot;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		void release_snapshot(Snapshot &snapshot) const override
+		{
+			_drop(snapshot);
+		}
+
 		virtual size_t size() const override { return _size; }
 
 		Name name() const { return _name; }
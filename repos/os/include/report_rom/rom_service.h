@@ -35,6 +35,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 		Genode::Ram_allocator &_ram;
 		Genode::Region_map    &_rm;
 
@@ -53,6 +59,20 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
+		/**
+		 * Revision of the content shared with other readers, used instead
+		 * of '_ds' if supported by the module
+		 */
+		Snapshot *_snapshot = nullptr;
+
+		void _release_snapshot()
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
 		size_t _content_size = 0;
 
 		/**
@@ -81,6 +101,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			_release_snapshot();
 			_registry.release(*this, _module);
 		}
 
@@ -90,6 +111,16 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+				/* hand out the current revision without copying */
+				_release_snapshot();
+				_snapshot = _module.acquire_snapshot(*this);
+				if (_snapshot) {
+					_ds.destruct();
+					_content_size = _snapshot->size();
+					_valid = _content_size > 0;
+					return _snapshot->dataspace();
+				}
+
 				/* replace dataspace by new one */
 				/* XXX we could keep the old dataspace if the size fits */
 				_ds.construct(_ram, _rm, _module.size());
@@ -107,6 +138,18 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/*
+			 * A snapshot is immutable, so the client must obtain a new
+			 * dataspace for a new revision.
+			 */
+			Snapshot * const curr = _module.acquire_snapshot(*this);
+			if (curr || _snapshot) {
+				bool const unchanged = (curr == _snapshot);
+				if (curr)
+					_module.release_snapshot(*curr);
+				return unchanged;
+			}
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
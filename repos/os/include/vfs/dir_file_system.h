@@ -159,6 +159,151 @@ class Vfs::Dir_file_system : public File_system
 		typedef String<MAX_NAME_LEN> Name;
 		Name const _name;
 
+		/**
+		 * Route of paths to the child file systems that may host them
+		 */
+		struct Route
+		{
+			char const   *name   = "";
+			File_system **fs     = nullptr;
+			unsigned      num_fs = 0;
+		};
+
+		/*
+		 * For each distinct top-level name announced by a child file system,
+		 * '_routes' holds the ordered list of children that may host paths
+		 * starting with this name, i.e., the children of this name and all
+		 * children that host arbitrary top-level nodes. Paths starting with
+		 * any other name take the '_default_route', which consists of the
+		 * latter only. Hence, if no child hosts arbitrary nodes, lookups of
+		 * unknown names fail without consulting any child. Paths without
+		 * any element are propagated to all children via '_all_route'.
+		 *
+		 * The routes depend solely on the static structure of the VFS
+		 * configuration, which is not changed by 'apply_config'.
+		 */
+		Route    *_routes     = nullptr;
+		unsigned  _num_routes = 0;
+		Route     _default_route { };
+		Route     _all_route     { };
+
+		unsigned _num_file_systems() const
+		{
+			unsigned count = 0;
+			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+				count++;
+			return count;
+		}
+
+		void _build_routes()
+		{
+			Genode::Allocator &alloc = _env.alloc();
+
+			unsigned const num_fs = _num_file_systems();
+			if (!num_fs)
+				return;
+
+			auto route_for_name = [&] (char const *name)
+			{
+				Route route { name,
+				              (File_system **)alloc.alloc(num_fs*sizeof(File_system *)),
+				              0 };
+
+				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+					char const * const fs_name = fs->top_level_name();
+					if (!*fs_name || (name && strcmp(fs_name, name) == 0))
+						route.fs[route.num_fs++] = fs;
+				}
+				return route;
+			};
+
+			/* route via all file systems, regardless of their names */
+			_all_route.fs = (File_system **)alloc.alloc(num_fs*sizeof(File_system *));
+			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+				_all_route.fs[_all_route.num_fs++] = fs;
+
+			_default_route = route_for_name(nullptr);
+			_default_route.name = "";
+
+			_routes = (Route *)alloc.alloc(num_fs*sizeof(Route));
+
+			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+
+				char const * const name = fs->top_level_name();
+				if (!*name)
+					continue;
+
+				/* insert route sorted by name, skip duplicates */
+				unsigned pos = 0;
+				for (; pos < _num_routes && strcmp(_routes[pos].name, name) < 0; pos++);
+
+				if (pos < _num_routes && strcmp(_routes[pos].name, name) == 0)
+					continue;
+
+				for (unsigned i = _num_routes; i > pos; i--)
+					_routes[i] = _routes[i - 1];
+
+				_routes[pos] = route_for_name(name);
+				_num_routes++;
+			}
+		}
+
+		void _destroy_routes()
+		{
+			Genode::Allocator &alloc = _env.alloc();
+
+			unsigned const num_fs = _num_file_systems();
+
+			auto destroy_route = [&] (Route &route) {
+				if (route.fs)
+					alloc.free(route.fs, num_fs*sizeof(File_system *)); };
+
+			for (unsigned i = 0; i < _num_routes; i++)
+				destroy_route(_routes[i]);
+
+			if (_routes)
+				alloc.free(_routes, num_fs*sizeof(Route));
+
+			destroy_route(_default_route);
+			destroy_route(_all_route);
+		}
+
+		/**
+		 * Return route for the first element of the given path
+		 */
+		Route const &_route(char const *path) const
+		{
+			while (*path == '/')
+				path++;
+
+			Genode::size_t len = 0;
+			for (; path[len] && path[len] != '/'; len++);
+
+			if (len == 0)
+				return _all_route;
+
+			/* binary search of the route named after the path element */
+			unsigned lo = 0, hi = _num_routes;
+			while (lo < hi) {
+
+				unsigned const mid  = lo + (hi - lo)/2;
+				char     const *name = _routes[mid].name;
+
+				int cmp = strcmp(name, path, len);
+				if (cmp == 0 && name[len] != 0)
+					cmp = 1;
+
+				if (cmp == 0)
+					return _routes[mid];
+
+				if (cmp < 0)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return _default_route;
+		}
+
 		/**
 		 * Returns if path corresponds to top directory of file system
 		 */
@@ -206,12 +351,13 @@ class Vfs::Dir_file_system : public File_system
 
 			/*
 			 * The given path refers to at least one of our sub directories.
-			 * Propagate the request into all of our file systems. If at least
-			 * one operation succeeds, we return success.
+			 * Propagate the request into all file systems that may host the
+			 * path. If at least one operation succeeds, we return success.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
 
-				RES const err = fn(*fs, path);
+				RES const err = fn(*route.fs[i], path);
 
 				if (err == ok)
 					return err;
@@ -268,9 +414,9 @@ class Vfs::Dir_file_system : public File_system
 		file_size _sum_dirents_of_file_systems(char const *path)
 		{
 			file_size cnt = 0;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-				cnt += fs->num_dirent(path);
-			}
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++)
+				cnt += route.fs[i]->num_dirent(path);
 			return cnt;
 		}
 
@@ -407,8 +553,12 @@ class Vfs::Dir_file_system : public File_system
 					}
 				} catch (Xml_node::Nonexistent_attribute) { }
 			}
+
+			_build_routes();
 		}
 
+		~Dir_file_system() { _destroy_routes(); }
+
 		/*********************************
 		 ** Directory-service interface **
 		 *********************************/
@@ -423,9 +573,9 @@ class Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
-				Dataspace_capability ds = fs->dataspace(path);
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
+				Dataspace_capability ds = route.fs[i]->dataspace(path);
 				if (ds.valid())
 					return ds;
 			}
@@ -439,8 +589,9 @@ class Vfs::Dir_file_system : public File_system
 			if (!path)
 				return;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
-				fs->release(path, ds_cap);
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++)
+				route.fs[i]->release(path, ds_cap);
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
@@ -469,11 +620,12 @@ class Vfs::Dir_file_system : public File_system
 
 			/*
 			 * The given path refers to one of our sub directories.
-			 * Propagate the request into our file systems.
+			 * Propagate the request into the file systems that may host it.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
 
-				Stat_result const err = fs->stat(path, out);
+				Stat_result const err = route.fs[i]->stat(path, out);
 
 				if (err == STAT_OK)
 					return err;
@@ -528,8 +680,9 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
-				if (fs->directory(path))
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++)
+				if (route.fs[i]->directory(path))
 					return true;
 
 			return false;
@@ -544,8 +697,9 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-				char const *leaf_path = fs->leaf_path(path);
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
+				char const *leaf_path = route.fs[i]->leaf_path(path);
 				if (leaf_path)
 					return leaf_path;
 			}
@@ -595,9 +749,10 @@ class Vfs::Dir_file_system : public File_system
 			}
 
 			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const &route = _route(path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
 
-				Open_result const err = fs->open(path, mode, out_handle, alloc);
+				Open_result const err = route.fs[i]->open(path, mode, out_handle, alloc);
 				switch (err) {
 				case OPEN_ERR_UNACCESSIBLE:
 					continue;
@@ -619,10 +774,11 @@ class Vfs::Dir_file_system : public File_system
 		{
 			Opendir_result res = OPENDIR_ERR_LOOKUP_FAILED;
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				Route const &route = _route(sub_path);
+				for (unsigned i = 0; i < route.num_fs; i++) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
-					Opendir_result r = fs->opendir(
+					Opendir_result r = route.fs[i]->opendir(
 						sub_path, false, &sub_dir_handle, dir_vfs_handle.alloc());
 
 					switch (r) {
@@ -766,10 +922,11 @@ class Vfs::Dir_file_system : public File_system
 			char const *sub_path = _sub_path(path);
 			if (!sub_path) return res;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const &route = _route(sub_path);
+			for (unsigned i = 0; i < route.num_fs; i++) {
 				Vfs_watch_handle *sub_handle;
 
-				if (fs->watch(sub_path, &sub_handle, alloc) == WATCH_OK) {
+				if (route.fs[i]->watch(sub_path, &sub_handle, alloc) == WATCH_OK) {
 					if (meta_handle == nullptr) {
 						/* at least one non-static FS, allocate handle */
 						meta_handle = new (alloc) Dir_watch_handle(*this, alloc);
@@ -845,6 +1002,8 @@ class Vfs::Dir_file_system : public File_system
 		char const *name() const    { return "dir"; }
 		char const *type() override { return "dir"; }
 
+		char const *top_level_name() const override { return _name.string(); }
+
 		void apply_config(Genode::Xml_node const &node) override
 		{
 			using namespace Genode;
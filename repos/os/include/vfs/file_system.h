@@ -49,6 +49,16 @@ class Vfs::File_system : public Directory_service, public File_io_service
 		 * Return the file-system type
 		 */
 		virtual char const *type() = 0;
+
+		/**
+		 * Return name of the only top-level node hosted by the file system
+		 *
+		 * The 'Dir_file_system' uses this information to route paths
+		 * directly to the file systems responsible for their first path
+		 * element. File systems that may host arbitrary top-level nodes
+		 * return an empty string.
+		 */
+		virtual char const *top_level_name() const { return ""; }
 };
 
 #endif /* _INCLUDE__VFS__FILE_SYSTEM_H_ */
@@ -154,6 +154,13 @@ class Vfs::Single_file_system : public File_system
 		{ }
 
 
+		/***************************
+		 ** File_system interface **
+		 ***************************/
+
+		char const *top_level_name() const override { return _filename.string(); }
+
+
 		/*********************************
 		 ** Directory-service interface **
 		 *********************************/
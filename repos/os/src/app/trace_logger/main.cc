@@ -52,6 +52,7 @@ class Main
 		bool                    const  _verbose             { _config.attribute_value("verbose",  false) };
 		Microseconds            const  _period_us           { read_sec_attr(_config, "period_sec", DEFAULT_PERIOD_SEC) };
 		Number_of_bytes         const  _default_buf_sz      { _config.attribute_value("default_buffer", Number_of_bytes(DEFAULT_BUFFER)) };
+		bool                    const  _default_lossless    { _config.attribute_value("default_lossless", false) };
 		Timer::Periodic_timeout<Main>  _period              { _timer, *this, &Main::_handle_period, _period_us };
 		Heap                           _heap                { _env.ram(), _env.rm() };
 		Monitor_tree                   _monitors_0          { };
@@ -151,6 +152,7 @@ class Main
 			try {
 				Number_of_bytes const buffer_sz   = session_policy.attribute_value("buffer", _default_buf_sz);
 				Policy_name     const policy_name = session_policy.attribute_value("policy", _default_policy_name);
+				bool            const lossless    = session_policy.attribute_value("lossless", _default_lossless);
 				try {
 					_trace.trace(id.id, _policies.find_by_name(policy_name).id(), buffer_sz);
 				} catch (Policy_tree::No_match) {
@@ -158,7 +160,7 @@ class Main
 					_policies.insert(policy);
 					_trace.trace(id.id, policy.id(), buffer_sz);
 				}
-				monitors.insert(new (_heap) Monitor(_trace, _env.rm(), id));
+				monitors.insert(new (_heap) Monitor(_trace, _env.rm(), id, lossless));
 			}
 			catch (Trace::Already_traced         ) { warning("Cannot activate tracing: Already_traced"         ); return; }
 			catch (Trace::Source_is_dead         ) { warning("Cannot activate tracing: Source_is_dead"         ); return; }
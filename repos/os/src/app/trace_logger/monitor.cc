@@ -60,10 +60,11 @@ Monitor &Monitor::find_by_subject_id(Trace::Subject_id const subject_id)
 
 Monitor::Monitor(Trace::Connection &trace,
                  Region_map        &rm,
-                 Trace::Subject_id  subject_id)
+                 Trace::Subject_id  subject_id,
+                 bool               lossless)
 :
 	Monitor_base(trace, rm, subject_id),
-	_subject_id(subject_id), _buffer(_buffer_raw)
+	_subject_id(subject_id), _buffer(_buffer_raw, lossless)
 {
 	_update_info();
 }
@@ -66,7 +66,8 @@ class Monitor : public Monitor_base,
 
 		Monitor(Genode::Trace::Connection &trace,
 		        Genode::Region_map        &rm,
-		        Genode::Trace::Subject_id  subject_id);
+		        Genode::Trace::Subject_id  subject_id,
+		        bool                       lossless);
 
 		void print(bool activity, bool affinity);
 
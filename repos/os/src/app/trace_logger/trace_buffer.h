@@ -28,10 +28,39 @@ class Trace_buffer
 		Genode::Trace::Buffer        &_buffer;
 		Genode::Trace::Buffer::Entry  _curr          { _buffer.first() };
 		unsigned                      _wrapped_count { 0 };
+		unsigned                      _dropped_count { 0 };
+
+		template <typename FUNC>
+		void _for_each_streamed_entry(FUNC && functor)
+		{
+			using namespace Genode;
+
+			_buffer.for_each_new_entry([&] (Trace::Buffer::Entry const &entry) {
+				functor(entry); });
+
+			unsigned const dropped = _buffer.dropped();
+			if (dropped != _dropped_count) {
+				warning("buffer dropped ", dropped - _dropped_count, " entries; "
+				        "you might want to raise buffer size or shorten period");
+				_dropped_count = dropped;
+			}
+		}
 
 	public:
 
-		Trace_buffer(Genode::Trace::Buffer &buffer) : _buffer(buffer) { }
+		/**
+		 * Constructor
+		 *
+		 * \param lossless  stream entries without overwriting unconsumed
+		 *                  ones instead of polling the wrapping buffer
+		 */
+		Trace_buffer(Genode::Trace::Buffer &buffer, bool lossless)
+		:
+			_buffer(buffer)
+		{
+			if (lossless)
+				_buffer.stream_lossless();
+		}
 
 		/**
 		 * Call functor for each entry that wasn't yet processed
@@ -41,6 +70,11 @@ class Trace_buffer
 		{
 			using namespace Genode;
 
+			if (_buffer.lossless()) {
+				_for_each_streamed_entry(functor);
+				return;
+			}
+
 			bool wrapped = _buffer.wrapped() != _wrapped_count;
 			if (wrapped) {
 				if ((_buffer.wrapped() - 1) != _wrapped_count) {
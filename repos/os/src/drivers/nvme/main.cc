@@ -65,6 +65,7 @@ namespace Nvme {
 	struct Sqe_create_cq;
 	struct Sqe_create_sq;
 	struct Sqe_identify;
+	struct Sqe_set_features;
 	struct Sqe_io;
 
 	struct Queue;
@@ -78,14 +79,20 @@ namespace Nvme {
 		CQE_LEN                = 1u << CQE_LEN_LOG2,
 		SQE_LEN_LOG2           = 6u,
 		SQE_LEN                = 1u << SQE_LEN_LOG2,
-		MAX_IO_QUEUES          = 1,
 
 		/*
-		 * Limit max number of I/O slots. By now most controllers
+		 * Limit max number of I/O queue pairs. The number of queues
+		 * actually used is configurable and rounded down to the number
+		 * the controller supports.
+		 */
+		MAX_IO_QUEUES          = 16,
+
+		/*
+		 * Limit max number of I/O slots per queue. By now most controllers
 		 * should support >= 1024 but the current value is a trade-off
-		 * as all data structures are allocated statically. However,
-		 * the number of entries is rounded down to the number the
-		 * controller actually supports in case it is smaller.
+		 * as the command-id bitmaps are allocated statically. However,
+		 * the number of entries is configurable and rounded down to the
+		 * number the controller actually supports in case it is smaller.
 		 */
 		MAX_IO_ENTRIES         = 512,
 		MAX_IO_ENTRIES_MASK    = MAX_IO_ENTRIES - 1,
@@ -103,7 +110,6 @@ namespace Nvme {
 		 * according to the MDTS register.
 		 */
 		MAX_IO_LEN  = 2u << 20,
-		PRP_DS_SIZE = MAX_IO_ENTRIES * MPS,
 	};
 
 	enum {
@@ -113,7 +119,7 @@ namespace Nvme {
 		 */
 		IO_NSID    = 1u,
 		MAX_NS     = 1u,
-		NUM_QUEUES = 1 + MAX_NS,
+		NUM_QUEUES = 1 + MAX_IO_QUEUES,
 	};
 
 	enum Opcode {
@@ -331,6 +337,29 @@ struct Nvme::Sqe_identify : Nvme::Sqe
 };
 
 
+/*
+ * Set features command
+ */
+struct Nvme::Sqe_set_features : Nvme::Sqe
+{
+	enum Fid { NUMBER_OF_QUEUES = 0x07, };
+
+	struct Cdw10 : Register<0x28, 32>
+	{
+		struct Fid : Bitfield< 0, 8> { }; /* feature identifier */
+	};
+
+	struct Cdw11 : Register<0x2c, 32>
+	{
+		/* number of queues feature, 0-based values */
+		struct Nsqr : Bitfield< 0, 16> { }; /* number of I/O sq requested */
+		struct Ncqr : Bitfield<16, 16> { }; /* number of I/O cq requested */
+	};
+
+	Sqe_set_features(addr_t const base) : Sqe(base) { }
+};
+
+
 /*
  *  Create completion queue command
  */
@@ -625,20 +654,15 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	};
 
 	/*
-	 * I/O submission doorbell
-	 */
-	struct Io_sdb : Register<0x1008, 32>
-	{
-		struct Sqt : Bitfield< 0, 16> { }; /* submission queue tail */
-	};
-
-	/*
-	 * I/O completion doorbell
+	 * Queue doorbells
+	 *
+	 * The submission-queue tail doorbell of queue y is located at index
+	 * (2y << Cap::Dstrd), the completion-queue head doorbell at index
+	 * ((2y + 1) << Cap::Dstrd). Index 0 and 1 correspond to the admin
+	 * doorbells.
 	 */
-	struct Io_cdb : Register<0x100C, 32>
-	{
-		struct Cqh : Bitfield< 0, 16> { }; /* completion queue tail */
-	};
+	enum { MAX_DOORBELLS = 1024, };
+	struct Doorbells : Register_array<0x1000, 32, MAX_DOORBELLS, 32> { };
 
 	/**********
 	 ** CODE **
@@ -658,8 +682,8 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	Mmio::Delayer       &_delayer;
 
 	/*
-	 * There is a completion and submission queue for
-	 * every namespace and one pair for the admin queues.
+	 * There is one pair for the admin queues followed by
+	 * the pairs of I/O queues.
 	 */
 	Nvme::Cq _cq[NUM_QUEUES] { };
 	Nvme::Sq _sq[NUM_QUEUES] { };
@@ -679,6 +703,10 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	size_t _max_io_entries      { MAX_IO_ENTRIES };
 	size_t _max_io_entries_mask { _max_io_entries - 1 };
 
+	uint16_t _io_queues { 1 };
+
+	unsigned _doorbell_stride_log2 { 0 };
+
 	enum Cns {
 		IDENTIFY_NS = 0x00,
 		IDENTIFY    = 0x01,
@@ -693,6 +721,7 @@ struct Nvme::Controller : public Genode::Attached_mmio
 		QUERYNS_CID,
 		CREATE_IO_CQ_CID,
 		CREATE_IO_SQ_CID,
+		SET_FEATURES_CID,
 	};
 
 	Mem_address _nvme_query_ns[MAX_NS] { };
@@ -840,11 +869,12 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	 *
 	 * \param num  number of attempts
 	 * \param cid  command identifier
+	 * \param dw0  if not null, set to the command-specific result
 	 *
 	 * \return  returns true if attempt to wait was successfull, otherwise
 	 *          false is returned
 	 */
-	bool _wait_for_admin_cq(uint32_t num, uint16_t cid)
+	bool _wait_for_admin_cq(uint32_t num, uint16_t cid, uint32_t *dw0 = nullptr)
 	{
 		bool success = false;
 
@@ -857,6 +887,8 @@ struct Nvme::Controller : public Genode::Attached_mmio
 				continue;
 			}
 
+			if (dw0) { *dw0 = b.read<Nvme::Cqe::Dw0>(); }
+
 			_admin_cq.advance_head();
 
 			success = true;
@@ -992,11 +1024,63 @@ struct Nvme::Controller : public Genode::Attached_mmio
 
 		/* limit maximum queue length */
 		uint16_t const mqes = read<Cap::Mqes>() + 1;
-		_max_io_entries      = Genode::min((uint16_t)Nvme::MAX_IO_ENTRIES,
-		                                   mqes);
+		_max_io_entries      = _io_entries(Genode::min(_max_io_entries, (size_t)mqes));
 		_max_io_entries_mask = _max_io_entries - 1;
 	}
 
+	/**
+	 * Return valid number of entries per I/O queue for 'entries'
+	 *
+	 * The ring indices are wrapped via '_max_io_entries_mask', which
+	 * requires the number of entries to be a power of two. A queue needs
+	 * at least two entries to distinguish a full from an empty queue.
+	 */
+	static size_t _io_entries(size_t const entries)
+	{
+		size_t const limited = Genode::min(Genode::max(entries, (size_t)2),
+		                                   (size_t)MAX_IO_ENTRIES);
+		return (size_t)1 << Genode::log2(limited);
+	}
+
+	/**
+	 * Negotiate number of I/O queue pairs with the controller
+	 *
+	 * \param requested  number of requested queue pairs
+	 */
+	void _set_io_queues(uint16_t requested)
+	{
+		/* limit number of queues to the available doorbell registers */
+		while (requested > 1 &&
+		       ((2u*requested + 1) << _doorbell_stride_log2) >= MAX_DOORBELLS)
+			requested--;
+
+		Sqe_set_features b(_admin_command(Opcode::SET_FEATURES, 0, SET_FEATURES_CID));
+		b.write<Nvme::Sqe_set_features::Cdw10::Fid>(Nvme::Sqe_set_features::NUMBER_OF_QUEUES);
+		b.write<Nvme::Sqe_set_features::Cdw11::Nsqr>(requested - 1);
+		b.write<Nvme::Sqe_set_features::Cdw11::Ncqr>(requested - 1);
+
+		write<Admin_sdb::Sqt>(_admin_sq.tail);
+
+		uint32_t allocated = 0;
+		if (!_wait_for_admin_cq(10, SET_FEATURES_CID, &allocated)) {
+			warning("set number of queues failed, using one I/O queue");
+			_io_queues = 1;
+			return;
+		}
+
+		/* the result contains the 0-based number of allocated queues */
+		uint16_t const nsqa = (uint16_t)(allocated & 0xffffu) + 1;
+		uint16_t const ncqa = (uint16_t)(allocated >> 16)     + 1;
+
+		_io_queues = Genode::min(requested, Genode::min(nsqa, ncqa));
+	}
+
+	uint32_t _sq_doorbell(uint16_t qid) const {
+		return (2u*qid) << _doorbell_stride_log2; }
+
+	uint32_t _cq_doorbell(uint16_t qid) const {
+		return (2u*qid + 1) << _doorbell_stride_log2; }
+
 	/**
 	 * Setup I/O completion queue
 	 *
@@ -1058,10 +1142,15 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	 */
 	Controller(Genode::Env &env, Util::Dma_allocator &dma_alloc,
 	           addr_t const base, size_t const size,
-	           Mmio::Delayer &delayer)
+	           Mmio::Delayer &delayer,
+	           uint16_t const max_io_queues,
+	           uint16_t const max_io_entries)
 	:
 		Genode::Attached_mmio(env, base, size),
-		_env(env), _dma_alloc(dma_alloc), _delayer(delayer)
+		_env(env), _dma_alloc(dma_alloc), _delayer(delayer),
+		_max_io_entries(_io_entries(max_io_entries)),
+		_io_queues(Genode::max(Genode::min(max_io_queues, (uint16_t)MAX_IO_QUEUES),
+		                       (uint16_t)1))
 	{ }
 
 	/**
@@ -1071,6 +1160,8 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	 */
 	void init()
 	{
+		_doorbell_stride_log2 = read<Cap::Dstrd>();
+
 		_reset();
 		_setup_admin();
 
@@ -1103,27 +1194,35 @@ struct Nvme::Controller : public Genode::Attached_mmio
 		_identify();
 		_query_nslist();
 		_query_ns();
+		_set_io_queues(_io_queues);
 	}
 
 	/**
-	 * Setup I/O queue
+	 * Setup I/O queues
+	 *
+	 * Each I/O submission queue uses the completion queue of the
+	 * same identifier.
 	 */
-	void setup_io(uint16_t cid, uint16_t sid)
+	void setup_io()
 	{
-		_setup_io_cq(cid);
-		_setup_io_sq(sid, cid);
+		for (uint16_t qid = 1; qid <= _io_queues; qid++) {
+			_setup_io_cq(qid);
+			_setup_io_sq(qid, qid);
+		}
 	}
 
 	/**
 	 * Get next free IO submission queue slot
 	 *
+	 * \param qid   queue identifier
 	 * \param nsid  namespace identifier
+	 * \param cid   command identifier
 	 *
 	 * \return  returns virtual address of the I/O command
 	 */
-	addr_t io_command(uint16_t nsid, uint16_t cid)
+	addr_t io_command(uint16_t qid, uint16_t nsid, uint16_t cid)
 	{
-		Nvme::Sq &sq = _sq[nsid];
+		Nvme::Sq &sq = _sq[qid];
 
 		Sqe e(sq.next());
 		e.write<Nvme::Sqe::Cdw0::Cid>(cid);
@@ -1134,38 +1233,38 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	/**
 	 * Check if I/O queue is full
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 *
 	 * \return  true if full, otherwise false
 	 */
-	bool io_queue_full(uint16_t nsid) const
+	bool io_queue_full(uint16_t qid) const
 	{
-		Nvme::Sq const &sq = _sq[nsid];
-		Nvme::Cq const &cq = _cq[nsid];
+		Nvme::Sq const &sq = _sq[qid];
+		Nvme::Cq const &cq = _cq[qid];
 		return _queue_full(sq, cq);
 	}
 
 	/**
 	 * Write current I/O submission queue tail
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 */
-	void commit_io(uint16_t nsid)
+	void commit_io(uint16_t qid)
 	{
-		Nvme::Sq &sq = _sq[nsid];
-		write<Io_sdb::Sqt>(sq.tail);
+		Nvme::Sq &sq = _sq[qid];
+		write<Doorbells>(sq.tail, _sq_doorbell(qid));
 	}
 
 	/**
 	 * Process a pending I/O completion
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid   queue identifier
 	 * \param func  function that is called on each completion
 	 */
 	template <typename FUNC>
-	void handle_io_completion(uint16_t nsid, FUNC const &func)
+	void handle_io_completion(uint16_t qid, FUNC const &func)
 	{
-		Nvme::Cq &cq = _cq[nsid];
+		Nvme::Cq &cq = _cq[qid];
 
 		if (!cq.valid()) { return; }
 
@@ -1189,12 +1288,12 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	/**
 	 * Acknowledge every pending I/O already handled
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 */
-	void ack_io_completions(uint16_t nsid)
+	void ack_io_completions(uint16_t qid)
 	{
-		Nvme::Cq &cq = _cq[nsid];
-		write<Io_cdb::Cqh>(cq.head);
+		Nvme::Cq &cq = _cq[qid];
+		write<Doorbells>(cq.head, _cq_doorbell(qid));
 	}
 
 	/**
@@ -1232,6 +1331,13 @@ struct Nvme::Controller : public Genode::Attached_mmio
 	 */
 	uint16_t max_io_entries() const { return _max_io_entries; }
 
+	/**
+	 * Get number of I/O queue pairs
+	 *
+	 * \return  returns number of I/O queue pairs in use
+	 */
+	uint16_t io_queues() const { return _io_queues; }
+
 	/***********
 	 ** Debug **
 	 ***********/
@@ -1410,9 +1516,9 @@ class Nvme::Driver : Genode::Noncopyable
 
 			Genode::Ram_dataspace_capability dataspace() { return _ds; }
 
-			Page page(uint16_t cid)
+			Page page(uint32_t index)
 			{
-				addr_t const offset = cid * Nvme::MPS;
+				addr_t const offset = index * Nvme::MPS;
 
 				return Page { .pa = offset + _phys_addr,
 				              .va = offset + _virt_addr };
@@ -1464,22 +1570,89 @@ class Nvme::Driver : Genode::Noncopyable
 			}
 		};
 
-		Command_id<Nvme::MAX_IO_ENTRIES> _command_id_allocator { };
-		Request                          _requests[Nvme::MAX_IO_ENTRIES] { };
+		/*
+		 * Command identifiers are unique per I/O queue, queue 'qid' uses
+		 * the allocator at index 'qid - 1'.
+		 */
+		Command_id<Nvme::MAX_IO_ENTRIES> _command_id_allocator[Nvme::MAX_IO_QUEUES] { };
+
+		/*
+		 * Requests of all I/O queues, allocated once the number of queues
+		 * and entries is known
+		 */
+		Request *_requests     { nullptr };
+		size_t   _num_requests { 0 };
+
+		uint32_t _request_index(uint16_t qid, uint16_t cid) const
+		{
+			return (uint32_t)(qid - 1) * _nvme_ctrlr->max_io_entries() + cid;
+		}
 
 		template <typename FUNC>
 		bool _for_any_request(FUNC const &func) const
 		{
-			for (uint16_t i = 0; i < _nvme_ctrlr->max_io_entries(); i++) {
-				if (_command_id_allocator.used(i) && func(_requests[i])) {
-					return true;
+			for (uint16_t qid = 1; qid <= _nvme_ctrlr->io_queues(); qid++) {
+
+				Command_id<Nvme::MAX_IO_ENTRIES> const &ids =
+					_command_id_allocator[qid - 1];
+
+				for (uint16_t cid = 0; cid < _nvme_ctrlr->max_io_entries(); cid++) {
+					if (ids.used(cid) && func(_requests[_request_index(qid, cid)])) {
+						return true;
+					}
 				}
 			}
 			return false;
 		}
 
-		bool _submits_pending   { false };
-		bool _completed_pending { false };
+		/* bitmasks of I/O queues with pending submits and completions */
+		uint32_t _submits_pending   { 0 };
+		uint32_t _completed_pending { 0 };
+
+		/* queue used for the next submission and checked for completions */
+		uint16_t _next_submit_queue     { 1 };
+		uint16_t _next_completion_queue { 1 };
+
+		/**
+		 * Return I/O queue that is able to take the next request
+		 *
+		 * The requests are spread round-robin across all I/O queues.
+		 *
+		 * \return  queue identifier or 0 if all queues are full
+		 */
+		uint16_t _submit_queue() const
+		{
+			uint16_t const queues = _nvme_ctrlr->io_queues();
+
+			for (uint16_t i = 0; i < queues; i++) {
+				uint16_t const qid = (uint16_t)((_next_submit_queue - 1 + i) % queues) + 1;
+				if (!_nvme_ctrlr->io_queue_full(qid)) {
+					return qid;
+				}
+			}
+			return 0;
+		}
+
+		/**
+		 * Allocate command identifier and request slot in next I/O queue
+		 *
+		 * The identifiers of the chosen queue and command are returned
+		 * via 'qid' and 'cid'.
+		 */
+		void _alloc_request(Block::Request const &request,
+		                        uint16_t &qid, uint16_t &cid)
+		{
+			qid = _submit_queue();
+			cid = _command_id_allocator[qid - 1].alloc();
+
+			_next_submit_queue = (uint16_t)(qid % _nvme_ctrlr->io_queues()) + 1;
+
+			Request &r = _requests[_request_index(qid, cid)];
+			r = Request { .block_request = request,
+			              .id            = (uint32_t)cid | ((uint32_t)qid << 16) };
+
+			_submits_pending |= 1u << qid;
+		}
 
 		/*********************
 		 ** MMIO Controller **
@@ -1516,6 +1689,12 @@ class Nvme::Driver : Genode::Noncopyable
 			_config_rom.sigh(_config_sigh);
 			_handle_config_update();
 
+			uint16_t const max_io_queues =
+				_config_rom.xml().attribute_value("max_io_queues", (uint16_t)1);
+			uint16_t const max_io_entries =
+				_config_rom.xml().attribute_value("max_io_entries",
+				                                  (uint16_t)Nvme::MAX_IO_ENTRIES);
+
 			/*
 			 * Setup and identify NVMe PCI controller
 			 */
@@ -1529,7 +1708,8 @@ class Nvme::Driver : Genode::Noncopyable
 
 			try {
 				_nvme_ctrlr.construct(_env, *_nvme_pci, _nvme_pci->base(),
-				                      _nvme_pci->size(), _delayer);
+				                      _nvme_pci->size(), _delayer,
+				                      max_io_queues, max_io_entries);
 			} catch (...) {
 				error("could not access NVMe controller MMIO");
 				throw;
@@ -1549,8 +1729,18 @@ class Nvme::Driver : Genode::Noncopyable
 			 * Setup I/O
 			 */
 
+			_num_requests = (size_t)_nvme_ctrlr->io_queues()
+			              * _nvme_ctrlr->max_io_entries();
+			_requests = (Request *)_alloc.alloc(_num_requests * sizeof(Request));
+			for (size_t i = 0; i < _num_requests; i++) {
+				construct_at<Request>(&_requests[i]);
+			}
+
 			{
-				Genode::Ram_dataspace_capability ds = _nvme_pci->alloc(Nvme::PRP_DS_SIZE);
+				/* one PRP list page per request */
+				size_t const prp_ds_size = _num_requests * Nvme::MPS;
+
+				Genode::Ram_dataspace_capability ds = _nvme_pci->alloc(prp_ds_size);
 				if (!ds.valid()) {
 					error("could not allocate DMA backing store");
 					throw Nvme::Controller::Initialization_failed();
@@ -1561,13 +1751,13 @@ class Nvme::Driver : Genode::Noncopyable
 
 				if (_verbose_mem) {
 					log("DMA", " virt: [", Hex(virt_addr), ",",
-					           Hex(virt_addr + Nvme::PRP_DS_SIZE), "]",
+					           Hex(virt_addr + prp_ds_size), "]",
 					           " phys: [", Hex(phys_addr), ",",
-					           Hex(phys_addr + Nvme::PRP_DS_SIZE), "]");
+					           Hex(phys_addr + prp_ds_size), "]");
 				}
 			}
 
-			_nvme_ctrlr->setup_io(Nvme::IO_NSID, Nvme::IO_NSID);
+			_nvme_ctrlr->setup_io();
 
 			/*
 			 * Setup Block session
@@ -1595,6 +1785,7 @@ class Nvme::Driver : Genode::Noncopyable
 			log("Block", " "
 			    "size: ",  _info.block_size, " "
 			    "count: ", _info.block_count, " "
+			    "I/O queues: ",  _nvme_ctrlr->io_queues(), " "
 			    "I/O entries: ", _nvme_ctrlr->max_io_entries());
 
 			/* generate Report if requested */
@@ -1611,7 +1802,11 @@ class Nvme::Driver : Genode::Noncopyable
 			_nvme_pci->ack_irq();
 		}
 
-		~Driver() { /* free resources */ }
+		~Driver()
+		{
+			/* free resources */
+			if (_requests) { _alloc.free(_requests, _num_requests * sizeof(Request)); }
+		}
 
 		Block::Session::Info info() const { return _info; }
 
@@ -1639,10 +1834,10 @@ class Nvme::Driver : Genode::Noncopyable
 		{
 			/*
 			 * All memory is dimensioned in a way that it will allow for
-			 * MAX_IO_ENTRIES requests, so it is safe to only check the
-			 * I/O queue.
+			 * 'max_io_entries' requests per I/O queue, so it is safe to
+			 * only check the I/O queues.
 			 */
-			if (_nvme_ctrlr->io_queue_full(Nvme::IO_NSID)) {
+			if (!_submit_queue()) {
 				return Response::RETRY;
 			}
 
@@ -1723,13 +1918,10 @@ class Nvme::Driver : Genode::Noncopyable
 				    " offset: ", Hex(request.offset));
 			}
 
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t qid { 0 }, cid { 0 };
+			_alloc_request(request, qid, cid);
 
-			Nvme::Sqe_io b(_nvme_ctrlr->io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(_nvme_ctrlr->io_command(qid, Nvme::IO_NSID, cid));
 			Nvme::Opcode const op = write ? Nvme::Opcode::WRITE : Nvme::Opcode::READ;
 			b.write<Nvme::Sqe::Cdw0::Opc>(op);
 			b.write<Nvme::Sqe::Prp1>(request_pa);
@@ -1740,7 +1932,8 @@ class Nvme::Driver : Genode::Noncopyable
 			} else if (need_list) {
 
 				/* get page to store list of mps chunks */
-				Prp_list_helper::Page page = _prp_list_helper->page(cid);
+				Prp_list_helper::Page page =
+					_prp_list_helper->page(_request_index(qid, cid));
 
 				/* omit first page and write remaining pages to iob */
 				addr_t  npa = request_pa + Nvme::MPS;
@@ -1770,28 +1963,22 @@ class Nvme::Driver : Genode::Noncopyable
 
 		void _submit_sync(Block::Request const request)
 		{
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t qid { 0 }, cid { 0 };
+			_alloc_request(request, qid, cid);
 
-			Nvme::Sqe_io b(_nvme_ctrlr->io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(_nvme_ctrlr->io_command(qid, Nvme::IO_NSID, cid));
 			b.write<Nvme::Sqe::Cdw0::Opc>(Nvme::Opcode::FLUSH);
 		}
 
 		void _submit_trim(Block::Request const request)
 		{
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t qid { 0 }, cid { 0 };
+			_alloc_request(request, qid, cid);
 
 			size_t          const count = request.operation.count;
 			Block::sector_t const lba   = request.operation.block_number;
 
-			Nvme::Sqe_io b(_nvme_ctrlr->io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(_nvme_ctrlr->io_command(qid, Nvme::IO_NSID, cid));
 			b.write<Nvme::Sqe::Cdw0::Opc>(Nvme::Opcode::WRITE_ZEROS);
 			b.write<Nvme::Sqe_io::Slba>(lba);
 
@@ -1804,34 +1991,52 @@ class Nvme::Driver : Genode::Noncopyable
 			b.write<Nvme::Sqe_io::Cdw12::Nlb>(count - 1); /* 0-base value */
 		}
 
-		void _get_completed_request(Block::Request &out, uint16_t &out_cid)
+		void _get_completed_request(Block::Request &out, uint16_t &out_qid,
+		                            uint16_t &out_cid)
 		{
-			_nvme_ctrlr->handle_io_completion(Nvme::IO_NSID, [&] (Nvme::Cqe const &b) {
-
-				if (_verbose_io) { Nvme::Cqe::dump(b); }
-
-				uint32_t const id  = Nvme::Cqe::request_id(b);
-				uint16_t const cid = Nvme::Cqe::command_id(b);
-				Request &r = _requests[cid];
-				if (r.id != id) {
-					error("no pending request found for CQ entry: id: ",
-					      id, " != r.id: ", r.id);
-					Nvme::Cqe::dump(b);
-					return;
-				}
+			uint16_t const queues = _nvme_ctrlr->io_queues();
 
-				out_cid = cid;
+			/* check the completion queues round-robin for fairness */
+			for (uint16_t i = 0; i < queues && !out.operation.valid(); i++) {
 
-				r.block_request.success = Nvme::Cqe::succeeded(b);
-				out = r.block_request;
+				uint16_t const qid = _next_completion_queue;
+				_next_completion_queue = (uint16_t)(qid % queues) + 1;
 
-				_completed_pending = true;
-			});
+				_nvme_ctrlr->handle_io_completion(qid, [&] (Nvme::Cqe const &b) {
+
+					if (_verbose_io) { Nvme::Cqe::dump(b); }
+
+					uint32_t const id  = Nvme::Cqe::request_id(b);
+					uint16_t const cid = Nvme::Cqe::command_id(b);
+
+					_completed_pending |= 1u << qid;
+
+					if (cid >= _nvme_ctrlr->max_io_entries()) {
+						error("invalid command id in CQ entry: ", cid);
+						Nvme::Cqe::dump(b);
+						return;
+					}
+
+					Request &r = _requests[_request_index(qid, cid)];
+					if (r.id != id) {
+						error("no pending request found for CQ entry: id: ",
+						      id, " != r.id: ", r.id);
+						Nvme::Cqe::dump(b);
+						return;
+					}
+
+					out_qid = qid;
+					out_cid = cid;
+
+					r.block_request.success = Nvme::Cqe::succeeded(b);
+					out = r.block_request;
+				});
+			}
 		}
 
-		void _free_completed_request(uint16_t const cid)
+		void _free_completed_request(uint16_t const qid, uint16_t const cid)
 		{
-			_command_id_allocator.free(cid);
+			_command_id_allocator[qid - 1].free(cid);
 		}
 
 
@@ -1860,8 +2065,6 @@ class Nvme::Driver : Genode::Noncopyable
 			default:
 				return;
 			}
-
-			_submits_pending = true;
 		}
 
 		void mask_irq()
@@ -1879,22 +2082,27 @@ class Nvme::Driver : Genode::Noncopyable
 		{
 			if (!_submits_pending) { return false; }
 
-			_nvme_ctrlr->commit_io(Nvme::IO_NSID);
-			_submits_pending = false;
+			for (uint16_t qid = 1; qid <= _nvme_ctrlr->io_queues(); qid++) {
+				if (_submits_pending & (1u << qid)) {
+					_nvme_ctrlr->commit_io(qid);
+				}
+			}
+			_submits_pending = 0;
 			return true;
 		}
 
 		template <typename FN>
 		void with_any_completed_job(FN const &fn)
 		{
+			uint16_t qid { 0 };
 			uint16_t cid { 0 };
 			Block::Request request { };
 
-			_get_completed_request(request, cid);
+			_get_completed_request(request, qid, cid);
 
 			if (request.operation.valid()) {
 				fn(request);
-				_free_completed_request(cid);
+				_free_completed_request(qid, cid);
 			}
 		}
 
@@ -1902,8 +2110,12 @@ class Nvme::Driver : Genode::Noncopyable
 		{
 			if (!_completed_pending) { return; }
 
-			_nvme_ctrlr->ack_io_completions(Nvme::IO_NSID);
-			_completed_pending = false;
+			for (uint16_t qid = 1; qid <= _nvme_ctrlr->io_queues(); qid++) {
+				if (_completed_pending & (1u << qid)) {
+					_nvme_ctrlr->ack_io_completions(qid);
+				}
+			}
+			_completed_pending = 0;
 		}
 };
 
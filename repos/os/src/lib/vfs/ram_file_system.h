@@ -14,8 +14,7 @@
 #ifndef _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
-#include <ram_fs/chunk.h>
-#include <ram_fs/param.h>
+#include <ram_fs/extent.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
 #include <util/avl_tree.h>
@@ -26,9 +25,7 @@ namespace Vfs_ram {
 
 	using namespace Genode;
 	using namespace Vfs;
-	using namespace Ram_fs;
-	using File_system::Chunk;
-	using File_system::Chunk_index;
+	using File_system::Extent_map;
 
 	struct Io_handle;
 	struct Watch_handle;
@@ -257,49 +254,30 @@ class Vfs_ram::File : public Vfs_ram::Node
 {
 	private:
 
-		typedef Chunk      <num_level_3_entries()>                Chunk_level_3;
-		typedef Chunk_index<num_level_2_entries(), Chunk_level_3> Chunk_level_2;
-		typedef Chunk_index<num_level_1_entries(), Chunk_level_2> Chunk_level_1;
-		typedef Chunk_index<num_level_0_entries(), Chunk_level_1> Chunk_level_0;
-
-		Chunk_level_0 _chunk;
-		file_size     _length = 0;
+		Extent_map _extents;
+		file_size  _length = 0;
 
 	public:
 
 		File(char const *name, Allocator &alloc)
-		: Node(name), _chunk(alloc, 0) { }
+		: Node(name), _extents(alloc) { }
 
 		size_t read(char *dst, size_t len, file_size seek_offset) override
 		{
-			file_size const chunk_used_size = _chunk.used_size();
-
 			if (seek_offset >= _length)
 				return 0;
 
 			/*
-			 * Constrain read transaction to available chunk data
+			 * Constrain read transaction to the file length
 			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
+			 * Note that the extents may end below '_length' if the file
+			 * was extended via 'truncate'. The extent map reads holes and
+			 * the range beyond the written data as zeros.
 			 */
 			if (seek_offset + len >= _length)
 				len = _length - seek_offset;
 
-			file_size read_len = len;
-
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
-				else
-					read_len = 0;
-			}
-
-			_chunk.read(dst, read_len, seek_offset);
-
-			/* add zero padding if needed */
-			if (read_len < len)
-				memset(dst + read_len, 0, len - read_len);
+			_extents.read(dst, len, seek_offset);
 
 			return len;
 		}
@@ -316,30 +294,28 @@ class Vfs_ram::File : public Vfs_ram::Node
 		size_t write(char const *src, size_t len, file_size seek_offset) override
 		{
 			if (seek_offset == (file_size)(~0))
-				seek_offset = _chunk.used_size();
+				seek_offset = _extents.used_size();
 
-			if (seek_offset + len >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - (seek_offset + len);
-
-			try { _chunk.write(src, len, (size_t)seek_offset); }
-			catch (Out_of_memory) { return 0; }
+			/* the write is truncated if memory runs out */
+			size_t const written = _extents.write(src, len, seek_offset);
 
 			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
+			 * Keep track of file length. We cannot use 'used_size()' as
+			 * file length because the file may have been extended via
+			 * 'truncate' without writing.
 			 */
-			_length = max(_length, seek_offset + len);
+			if (written)
+				_length = max(_length, seek_offset + written);
 
-			return len;
+			return written;
 		}
 
 		file_size length() override { return _length; }
 
 		void truncate(file_size size) override
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			if (size < _extents.used_size())
+				_extents.truncate(size);
 
 			_length = size;
 		}
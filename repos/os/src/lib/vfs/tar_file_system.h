@@ -299,69 +299,205 @@ class Vfs::Tar_file_system : public File_system
 	typedef Genode::Token<Scanner_policy_path_element> Path_element_token;
 
 
+	/**
+	 * FNV-1a hash over 'len' characters of 's'
+	 */
+	static unsigned long _hash(char const *s, Genode::size_t len)
+	{
+		unsigned long h = 2166136261ul;
+		for (Genode::size_t i = 0; i < len && s[i]; i++)
+			h = (h ^ (unsigned char)s[i])*16777619ul;
+		return h;
+	}
+
+
 	struct Node : List<Node>, List<Node>::Element
 	{
-		char const *name;
+		char const   *name;
 		Record const *record;
+		Node   const *parent;
+
+		/* hash of 'parent' and 'name', used as key of the node index */
+		unsigned long const hash;
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
+		/* array of child nodes in list order, populated once the archive is parsed */
+		Node const **children     = nullptr;
+		file_size    num_children = 0;
 
-		Node *lookup(char const *name)
+		static unsigned long key(Node const *parent, char const *name, Genode::size_t len)
 		{
-			Absolute_path lookup_path(name);
+			return _hash(name, len) ^ ((Genode::addr_t)parent*0x9e3779b1ul);
+		}
 
-			Node *parent_node = this;
-			Node *child_node;
+		Node(char const *name, Record const *record, Node const *parent)
+		:
+			name(name), record(record), parent(parent),
+			hash(key(parent, name, strlen(name)))
+		{ }
 
-			Path_element_token t(lookup_path.base());
+		Node const *lookup_child(file_offset index) const
+		{
+			if (index < 0 || (file_size)index >= num_children)
+				return nullptr;
 
-			while (t) {
+			return children[index];
+		}
 
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
+		file_size num_dirent() const { return num_children; }
 
-				char path_element[MAX_PATH_LEN];
+		private:
 
-				t.string(path_element, sizeof(path_element));
+			/*
+			 * Noncopyable
+			 */
+			Node(Node const &);
+			Node &operator = (Node const &);
+
+	} _root_node;
+
+
+	/**
+	 * Open-addressing hash table of all nodes, keyed by parent node and name
+	 *
+	 * The table is filled while parsing the archive and never shrinks because
+	 * the archive content is immutable.
+	 */
+	class Node_index
+	{
+		private:
+
+			Genode::Allocator &_alloc;
 
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
+			enum { INITIAL_CAPACITY = 256 };
+
+			Node           **_slots    = nullptr;
+			Genode::size_t   _capacity = 0;   /* power of two */
+			Genode::size_t   _count    = 0;
+
+			void _insert_into_slots(Node &node)
+			{
+				Genode::size_t const mask = _capacity - 1;
+				for (Genode::size_t i = node.hash & mask; ; i = (i + 1) & mask) {
+					if (!_slots[i]) {
+						_slots[i] = &node;
+						return;
 					}
 				}
+			}
+
+			void _grow()
+			{
+				Node           **old_slots    = _slots;
+				Genode::size_t   old_capacity = _capacity;
+
+				_capacity = old_capacity ? 2*old_capacity : (Genode::size_t)INITIAL_CAPACITY;
+				_slots    = (Node **)_alloc.alloc(_capacity*sizeof(Node *));
+				memset(_slots, 0, _capacity*sizeof(Node *));
 
-				if (!child_node)
-					return 0;
+				for (Genode::size_t i = 0; i < old_capacity; i++)
+					if (old_slots[i])
+						_insert_into_slots(*old_slots[i]);
 
-				t = t.next();
+				if (old_slots)
+					_alloc.free(old_slots, old_capacity*sizeof(Node *));
 			}
 
-			return parent_node;
-		}
+			/*
+			 * Noncopyable
+			 */
+			Node_index(Node_index const &);
+			Node_index &operator = (Node_index const &);
 
+		public:
 
-		Node const *lookup_child(int index) const
-		{
-			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
+			Node_index(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+			~Node_index()
+			{
+				if (_slots)
+					_alloc.free(_slots, _capacity*sizeof(Node *));
 			}
 
-			return 0;
-		}
+			void insert(Node &node)
+			{
+				/* keep load factor below 3/4 */
+				if (4*(_count + 1) > 3*_capacity)
+					_grow();
 
+				_insert_into_slots(node);
+				_count++;
+			}
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
+			/**
+			 * Look up child of 'parent' named by the first 'len' characters of 'name'
+			 */
+			Node *lookup(Node const &parent, char const *name, Genode::size_t len) const
+			{
+				if (!_capacity)
+					return nullptr;
+
+				unsigned long  const hash = Node::key(&parent, name, len);
+				Genode::size_t const mask = _capacity - 1;
+
+				for (Genode::size_t i = hash & mask; _slots[i]; i = (i + 1) & mask) {
+					Node &node = *_slots[i];
+					if (node.hash == hash && node.parent == &parent
+					 && strcmp(node.name, name, len) == 0 && node.name[len] == 0)
+						return &node;
+				}
+				return nullptr;
+			}
+
+			template <typename FN>
+			void for_each(FN const &fn)
+			{
+				for (Genode::size_t i = 0; i < _capacity; i++)
+					if (_slots[i])
+						fn(*_slots[i]);
+			}
+
+	} _node_index { _alloc };
+
+
+	/**
+	 * Resolve path to node by following the node index element by element
+	 */
+	Node *_lookup(char const *path)
+	{
+		Absolute_path lookup_path(path);
+
+		Node *node = &_root_node;
+
+		for (Path_element_token t(lookup_path.base()); t; t = t.next()) {
+
+			if (t.type() != Path_element_token::IDENT)
+				continue;
+
+			node = _node_index.lookup(*node, t.start(), t.len());
+			if (!node)
+				return nullptr;
 		}
+		return node;
+	}
 
-	} _root_node;
+
+	/**
+	 * Populate the per-directory child arrays used for 'readdir'
+	 */
+	void _index_children(Node &dir)
+	{
+		file_size count = 0;
+		for (Node const *child = dir.first(); child; child = child->next())
+			count++;
+
+		if (!count)
+			return;
+
+		dir.children = (Node const **)_alloc.alloc(count*sizeof(Node const *));
+
+		for (Node const *child = dir.first(); child; child = child->next())
+			dir.children[dir.num_children++] = child;
+	}
 
 
 	/*
@@ -373,13 +509,15 @@ class Vfs::Tar_file_system : public File_system
 
 			Genode::Allocator &_alloc;
 
-			Node &_root_node;
+			Node       &_root_node;
+			Node_index &_node_index;
 
 		public:
 
 			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+			                Node              &root_node,
+			                Node_index        &node_index)
+			: _alloc(alloc), _root_node(root_node), _node_index(node_index) { }
 
 			void operator()(Record const *record)
 			{
@@ -414,10 +552,8 @@ class Vfs::Tar_file_system : public File_system
 
 					t.string(path_element, sizeof(path_element));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					child_node = _node_index.lookup(*parent_node, path_element,
+					                                strlen(path_element));
 
 					if (child_node) {
 
@@ -438,16 +574,17 @@ class Vfs::Tar_file_system : public File_system
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
+							child_node = new (_alloc) Node(name, record, parent_node);
 						} else {
 
 							/* create a directory node without record */
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
+							child_node = new (_alloc) Node(name, 0, parent_node);
 						}
 						parent_node->insert(child_node);
+						_node_index.insert(*child_node);
 					}
 
 					parent_node = child_node;
@@ -490,40 +627,67 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
+	/**
+	 * Direct-mapped cache of recently dereferenced paths
+	 *
+	 * As the archive is immutable, cached results including failed lookups
+	 * never become stale.
+	 */
+	struct Lookup_cache
 	{
-		Mutex            mutex { };
-		Node            &root_node;
-		bool             valid;              /* true after first lookup */
-		char             key[256];           /* key used for lookup */
-		file_size        cached_num_dirent;  /* cached value */
+		enum { NUM_ENTRIES = 64, MAX_CACHED_PATH_LEN = 128 };
+
+		struct Entry
+		{
+			bool        valid = false;
+			char        path[MAX_CACHED_PATH_LEN] { };
+			Node const *node = nullptr;
+		};
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		Mutex _mutex { };
+		Entry _entries[NUM_ENTRIES] { };
 
-		file_size num_dirent(char const *path)
+		static Entry &_entry(Entry *entries, char const *path)
 		{
-			Mutex::Guard guard(mutex);
-
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				copy_cstring(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
-			}
-			return cached_num_dirent;
+			return entries[_hash(path, MAX_CACHED_PATH_LEN) % NUM_ENTRIES];
+		}
+
+		/**
+		 * Return true if 'path' is cached, 'node' is set to the cached result
+		 */
+		bool lookup(char const *path, Node const *&node)
+		{
+			Mutex::Guard guard(_mutex);
+
+			Entry const &entry = _entry(_entries, path);
+			if (!entry.valid || strcmp(entry.path, path) != 0)
+				return false;
+
+			node = entry.node;
+			return true;
+		}
+
+		void insert(char const *path, Node const *node)
+		{
+			if (strlen(path) >= MAX_CACHED_PATH_LEN)
+				return;
+
+			Mutex::Guard guard(_mutex);
+
+			Entry &entry = _entry(_entries, path);
+			copy_cstring(entry.path, path, sizeof(entry.path));
+			entry.node  = node;
+			entry.valid = true;
 		}
-	} _cached_num_dirent;
+
+	} _lookup_cache { };
 
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
-	Node const *dereference(char const *path)
+	Node const *_dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
@@ -537,9 +701,9 @@ class Vfs::Tar_file_system : public File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -549,19 +713,35 @@ class Vfs::Tar_file_system : public File_system
 		return node;
 	}
 
+	/**
+	 * Walk hardlinks until we reach a file, consulting the lookup cache first
+	 */
+	Node const *dereference(char const *path)
+	{
+		Node const *node = nullptr;
+		if (_lookup_cache.lookup(path, node))
+			return node;
+
+		node = _dereference(path);
+		_lookup_cache.insert(path, node);
+		return node;
+	}
+
 	public:
 
 		Tar_file_system(Vfs::Env &env, Genode::Xml_node config)
 		:
 			_env(env.env()), _alloc(env.alloc()),
 			_rom_name(config.attribute_value("name", Rom_name())),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_root_node("", 0, nullptr)
 		{
 			Genode::log("tar archive '", _rom_name, "' "
 			            "local at ", (void *)_tar_base, ", size is ", _tar_size);
 
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			_for_each_tar_record_do(Add_node_action(_alloc, _root_node, _node_index));
+
+			_index_children(_root_node);
+			_node_index.for_each([&] (Node &node) { _index_children(node); });
 		}
 
 		/*********************************
@@ -658,14 +838,15 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_dirent() : 0;
 		}
 
 		bool directory(char const *path) override
@@ -687,7 +868,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node const *node = _lookup(path);
 			return node ? path : 0;
 		}
 
@@ -118,7 +118,8 @@ namespace Cache {
 		private:
 
 			char        _data[CHUNK_SIZE];
-			unsigned    _writes;
+			bool        _valid = false; /* holds the device content */
+			bool        _dirty = false; /* modified since last sync */
 
 		public:
 
@@ -136,12 +137,19 @@ namespace Cache {
 			 * of 'Chunk_index'.
 			 */
 			Chunk(Genode::Allocator &, offset_t base_offset, Chunk_base *p)
-			: Chunk_base(base_offset, p), _writes(0) { }
+			: Chunk_base(base_offset, p) { }
 
 			/**
 			 * Construct zero chunk
 			 */
-			Chunk() : _writes(0) { }
+			Chunk() { }
+
+			~Chunk() { POLICY::remove(this); }
+
+			/**
+			 * Return true if chunk was modified since the last sync
+			 */
+			bool dirty() const { return _dirty; }
 
 			/**
 			 * Return number of used entries
@@ -165,7 +173,31 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				_valid = true;
+				_dirty = true;
+			}
+
+			/**
+			 * Fill chunk with content read from the device
+			 *
+			 * A chunk that is valid already is left untouched because its
+			 * content may have been modified in the meantime.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				assert_valid_range(seek_offset, len, SIZE);
+
+				if (_valid) return;
+
+				POLICY::read(this);
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_valid = true;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -181,15 +213,15 @@ namespace Cache {
 			{
 				assert_valid_range(seek_offset, len, SIZE);
 
-				if (_writes == 0)
+				if (!_valid)
 					throw Range_incomplete(base_offset(), SIZE);
 			}
 
-			void sync(size_t len, offset_t seek_offset)
+			void sync(size_t, offset_t)
 			{
-				if (_writes > 1) {
+				if (_dirty) {
 					POLICY::sync(this, (char*)_data);
-					_writes = 1;
+					_dirty = false;
 				}
 			}
 
@@ -215,7 +247,7 @@ namespace Cache {
 
 			void free(size_t, offset_t)
 			{
-				if (_writes > 1) throw Dirty_chunk(_base_offset, SIZE);
+				if (_dirty) throw Dirty_chunk(_base_offset, SIZE);
 
 				_num_entries = 0;
 				if (_parent) _parent->free(SIZE, _base_offset);
@@ -409,6 +441,20 @@ namespace Cache {
 				}
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				static Entry &lookup(Chunk_index &chunk, unsigned i) {
+					return chunk._alloc_entry(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
 			struct Read_func
 			{
 				typedef ENTRY_TYPE const Entry;
@@ -515,6 +561,12 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Fill chunks with content read from the device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
 			/**
 			 * Allocate needed chunks
 			 */
@@ -44,14 +44,18 @@ class Driver : public Block::Driver
 				: srv(s), cli(c), buffer(b) {}
 
 			/*
-			 * \return true when the given response packet matches
+			 * \return true when the given response packet covers
 			 *         the request send to the backend device
+			 *
+			 * The request may be part of a larger read, into which
+			 * the requests of adjacent blocks were merged.
 			 */
 			bool match(const Block::Packet_descriptor& reply) const
 			{
-				return reply.operation()    == srv.operation()  &&
-				       reply.block_number() == srv.block_number() &&
-				       reply.block_count()  == srv.block_count();
+				return reply.operation()    == srv.operation()    &&
+				       reply.block_number() <= srv.block_number() &&
+				       srv.block_number()   + srv.block_count()
+				       <= reply.block_number() + reply.block_count();
 			}
 
 			/*
@@ -99,7 +103,10 @@ class Driver : public Block::Driver
 
 		enum {
 			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
-			CACHE_BLK_SIZE = 4096
+			CACHE_BLK_SIZE = 4096,
+			MAX_WRITE_BACK = 32*CACHE_BLK_SIZE, /* max. size of write request */
+			MAX_READ_BATCH = 32*CACHE_BLK_SIZE, /* max. size of merged read   */
+			MAX_READ_AHEAD = 64*CACHE_BLK_SIZE  /* max. read-ahead in bytes   */
 		};
 
 		/**
@@ -124,6 +131,39 @@ class Driver : public Block::Driver
 		Genode::Io_signal_handler<Driver> _source_ack;
 		Genode::Io_signal_handler<Driver> _source_submit;
 		Genode::Io_signal_handler<Driver> _yield;
+		Genode::size_t              const _read_ahead; /* in cache blocks   */
+
+		/*
+		 * Write request under construction
+		 *
+		 * Dirty chunks that are adjacent on the device are copied into one
+		 * packet, which is submitted as a single write request.
+		 */
+		struct Write_back
+		{
+			Block::Packet_descriptor packet { };
+			Cache::offset_t          off    { 0 };
+			Genode::size_t           size   { 0 };
+		};
+
+		Write_back _write_back { };
+
+		/*
+		 * Read request under construction
+		 *
+		 * Reads of adjacent blocks that are missing in the cache are merged
+		 * into one read request. The request is submitted once the session
+		 * handed over all pending client packets, or when a read of
+		 * non-adjacent blocks is needed.
+		 */
+		struct Pending_read
+		{
+			Block::Packet_descriptor packet { };
+			Block::sector_t          nr     { 0 };
+			Genode::size_t           cnt    { 0 };
+		};
+
+		Pending_read _pending_read { };
 
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
@@ -170,6 +210,129 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Submit pending write request to the backend device if possible
+		 *
+		 * \return false if the backend device is not ready to proceed
+		 */
+		bool _try_submit_write_back()
+		{
+			if (!_write_back.size)
+				return true;
+
+			if (!_blk.tx()->ready_to_submit())
+				return false;
+
+			Block::Packet_descriptor const p = _write_back.packet;
+
+			/*
+			 * Release the unused tail of the packet buffer. The packet
+			 * allocator frees exactly the given range of its blocks, and
+			 * the write-back size is a multiple of the allocator's block
+			 * size. The remainder is released on ack.
+			 */
+			if (_write_back.size < p.size())
+				_blk.tx()->release_packet(
+					Block::Packet_descriptor(p.offset() + _write_back.size,
+					                         p.size()   - _write_back.size));
+
+			_blk.tx()->submit_packet(
+				Block::Packet_descriptor(Block::Packet_descriptor(p.offset(),
+				                                                  _write_back.size),
+				                         Block::Packet_descriptor::WRITE,
+				                         _write_back.off  / _info.block_size,
+				                         _write_back.size / _info.block_size));
+
+			_write_back = Write_back();
+			return true;
+		}
+
+		/*
+		 * Submit pending read request to the backend device if possible
+		 *
+		 * \return false if the backend device is not ready to proceed
+		 */
+		bool _try_submit_pending_read()
+		{
+			if (!_pending_read.cnt)
+				return true;
+
+			if (!_blk.tx()->ready_to_submit())
+				return false;
+
+			Block::Packet_descriptor const p = _pending_read.packet;
+			Genode::size_t const size = _pending_read.cnt * _info.block_size;
+
+			/*
+			 * Release unused tail of the packet buffer, the read size is
+			 * rounded to the cache block size like the allocator blocks
+			 */
+			if (size < p.size())
+				_blk.tx()->release_packet(
+					Block::Packet_descriptor(p.offset() + size, p.size() - size));
+
+			_blk.tx()->submit_packet(
+				Block::Packet_descriptor(Block::Packet_descriptor(p.offset(), size),
+				                         Block::Packet_descriptor::READ,
+				                         _pending_read.nr, _pending_read.cnt));
+
+			_pending_read = Pending_read();
+			return true;
+		}
+
+		/*
+		 * Extend the pending read request by the adjacent blocks if possible
+		 *
+		 * \param nr   first block to read
+		 * \param cnt  number of blocks to read
+		 * \return     true if the blocks became part of the pending request
+		 */
+		bool _try_append_pending_read(Block::sector_t nr, Genode::size_t cnt)
+		{
+			Pending_read &pending = _pending_read;
+
+			if (!pending.cnt || nr != pending.nr + pending.cnt
+			 || (pending.cnt + cnt) * _info.block_size > pending.packet.size())
+				return false;
+
+			pending.cnt += cnt;
+			return true;
+		}
+
+		/*
+		 * Add content of dirty chunk to the pending write request
+		 *
+		 * \param off  device offset of the chunk
+		 * \param src  content of the chunk
+		 */
+		void _write_back_chunk(Cache::offset_t off, char const *src)
+		{
+			bool const append = _write_back.size
+			                 && off == _write_back.off + _write_back.size
+			                 && _write_back.size + CACHE_BLK_SIZE
+			                    <= _write_back.packet.size();
+			if (!append) {
+
+				if (!_try_submit_write_back())
+					throw Write_failed(off);
+
+				/* fall back to a single chunk if the buffer is fragmented */
+				try {
+					try {
+						_write_back.packet = _blk.alloc_packet(MAX_WRITE_BACK); }
+					catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+						_write_back.packet = _blk.alloc_packet(CACHE_BLK_SIZE); }
+				} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+					throw Write_failed(off); }
+
+				_write_back.off = off;
+			}
+
+			Genode::memcpy(_blk.tx()->packet_content(_write_back.packet)
+			               + _write_back.size, src, CACHE_BLK_SIZE);
+			_write_back.size += CACHE_BLK_SIZE;
+		}
+
 		/*
 		 * Handle acknowledgements from the backend device
 		 */
@@ -178,11 +341,11 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
-				/* when reading, write result into cache */
+				/* when reading, fill the not yet valid chunks with the result */
 				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _info.block_size,
-					             p.block_number() * _info.block_size);
+					_cache.fill(_blk.tx()->packet_content(p),
+					            p.block_count() * _info.block_size,
+					            p.block_number() * _info.block_size);
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
@@ -197,12 +360,45 @@ class Driver : public Block::Driver
 
 				_blk.tx()->release_packet(p);
 			}
+
+			_try_submit_pending_read();
+			_try_submit_write_back();
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit()
+		{
+			_try_submit_pending_read();
+			_try_submit_write_back();
+		}
+
+		/*
+		 * Extend device read request by chunks that are not cached yet
+		 *
+		 * \param nr   first block of the request
+		 * \param cnt  number of blocks, rounded to the cache block size
+		 * \return     number of blocks including the read-ahead
+		 */
+		Genode::size_t _with_read_ahead(Block::sector_t nr, Genode::size_t cnt)
+		{
+			for (Genode::size_t i = 0; i < _read_ahead; i++) {
+
+				Block::sector_t const next = nr + cnt;
+				if (next + _cache_blk_mod() > _info.block_count)
+					break;
+
+				/* stop at the first chunk that is already present */
+				try {
+					_cache.stat(CACHE_BLK_SIZE, next * _info.block_size);
+					break;
+				} catch (Cache::Chunk_base::Range_incomplete) { }
+
+				cnt += _cache_blk_mod();
+			}
+			return cnt;
+		}
 
 		/*
 		 * Setup a request to the backend device
@@ -216,8 +412,6 @@ class Driver : public Block::Driver
 		              char * const              buffer,
 		              Block::Packet_descriptor &packet)
 		{
-			Block::Packet_descriptor p_to_dev;
-
 			try {
 				/* we've to look whether the request is already pending */
 				for (Request *r = _r_list.first(); r; r = r->next()) {
@@ -228,32 +422,43 @@ class Driver : public Block::Driver
 					}
 				}
 
-				/* it doesn't pay, we've to send a request to the device */
-				if (!_blk.tx()->ready_to_submit()) {
-					Genode::warning("not ready_to_submit");
-					throw Request_congestion();
-				}
-
-				/* read ahead CACHE_BLK_SIZE */
+				/* read ahead CACHE_BLK_SIZE and the configured read-ahead */
 				Block::sector_t nr = _cache_blk_round_off(block_number);
 				Genode::size_t cnt = _cache_blk_round_up(block_count +
 				                                         (block_number - nr));
+				cnt = _with_read_ahead(nr, cnt);
 
 				/* ensure all memory is available before sending the request */
 				_cache.alloc(cnt * _info.block_size, nr * _info.block_size);
 
-				/* construct and send the packet */
-				p_to_dev =
-					Block::Packet_descriptor(_blk.alloc_packet(_info.block_size*cnt),
-					                         Block::Packet_descriptor::READ,
-					                         nr, cnt);
+				/* it doesn't pay, we've to send a request to the device */
+				if (!_try_append_pending_read(nr, cnt)) {
+
+					if (!_try_submit_pending_read() || !_blk.tx()->ready_to_submit()) {
+						Genode::warning("not ready_to_submit");
+						throw Request_congestion();
+					}
+
+					/* reserve room for merging the reads of adjacent blocks */
+					Genode::size_t const size = _info.block_size*cnt;
+					try {
+						_pending_read.packet =
+							_blk.alloc_packet(Genode::max(size, (Genode::size_t)MAX_READ_BATCH)); }
+					catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+						_pending_read.packet = _blk.alloc_packet(size); }
+
+					_pending_read.nr  = nr;
+					_pending_read.cnt = cnt;
+				}
+
+				Block::Packet_descriptor p_to_dev(Block::Packet_descriptor(),
+				                                  Block::Packet_descriptor::READ,
+				                                  nr, cnt);
 				_r_list.insert(new (&_r_slab) Request(p_to_dev, packet, buffer));
-				_blk.tx()->submit_packet(p_to_dev);
 			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 				throw Request_congestion();
 			} catch(Genode::Allocator::Out_of_memory) {
-				/* clean up */
-				_blk.tx()->release_packet(p_to_dev);
+				/* a read request already under construction is kept */
 				throw Request_congestion();
 			}
 		}
@@ -280,6 +485,9 @@ class Driver : public Block::Driver
 					_env.ep().wait_and_dispatch_one_io_signal();
 				}
 			}
+
+			while (!_try_submit_pending_read() || !_try_submit_write_back())
+				_env.ep().wait_and_dispatch_one_io_signal();
 		}
 
 		/*
@@ -320,6 +528,7 @@ class Driver : public Block::Driver
 
 			/* flush the requested amount of RAM from cache */
 			POLICY::flush(requested_ram_quota);
+			_try_submit_write_back();
 			_env.parent().yield_response();
 		}
 
@@ -328,9 +537,9 @@ class Driver : public Block::Driver
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param read_ahead  number of bytes to read ahead from the device
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap, Genode::size_t read_ahead)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
@@ -340,7 +549,9 @@ class Driver : public Block::Driver
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
-		  _yield(env.ep(), *this, &Driver::_parent_yield)
+		  _yield(env.ep(), *this, &Driver::_parent_yield),
+		  _read_ahead(Genode::min(read_ahead, (Genode::size_t)MAX_READ_AHEAD)
+		              / CACHE_BLK_SIZE)
 		{
 			using namespace Genode;
 
@@ -388,6 +599,7 @@ class Driver : public Block::Driver
 			            block_number*_info.block_size);
 
 			ack_packet(packet);
+			_try_submit_write_back();
 		}
 
 		void write(Block::sector_t           block_number,
@@ -415,7 +627,10 @@ class Driver : public Block::Driver
 			             block_number * _info.block_size);
 
 			ack_packet(packet);
+			_try_submit_write_back();
 		}
 
 		void sync() { _sync(); }
+
+		void batch_complete() { _try_submit_pending_read(); }
 };
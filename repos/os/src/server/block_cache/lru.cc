@@ -16,47 +16,67 @@
 
 typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
+/*
+ * The list is ordered from the least-recently used element at 'lru_first'
+ * to the most-recently used element at 'lru_last'. Each access moves the
+ * element to the end of the list in constant time.
+ */
+static const Lru_policy::Element *lru_first = nullptr;
+static const Lru_policy::Element *lru_last  = nullptr;
 
 
-static void lru_access(const Lru_policy::Element *e)
+void Lru_policy::remove(const Lru_policy::Element *e)
 {
-	if (e == lru) return;
+	if (!e->_listed) return;
 
-	if (e->next()) lru_list.remove(e);
+	if (e->_prev) e->_prev->_next = e->_next;
+	else          lru_first       = e->_next;
 
-	lru_list.insert(e, lru);
-	lru = e;
+	if (e->_next) e->_next->_prev = e->_prev;
+	else          lru_last        = e->_prev;
+
+	e->_prev   = nullptr;
+	e->_next   = nullptr;
+	e->_listed = false;
 }
 
 
-void Lru_policy::read(const Lru_policy::Element  *e) {
-	lru_access(e); }
+void Lru_policy::access(const Lru_policy::Element *e)
+{
+	if (e == lru_last) return;
 
+	remove(e);
 
-void Lru_policy::write(const Lru_policy::Element *e) {
-	lru_access(e); }
+	Element *elem = const_cast<Element *>(e);
+	Element *last = const_cast<Element *>(lru_last);
+
+	elem->_prev   = last;
+	elem->_next   = nullptr;
+	elem->_listed = true;
+
+	if (last) last->_next = elem;
+	else      lru_first   = elem;
+
+	lru_last = elem;
+}
 
 
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
-		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
-		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
-		}
-	}
 
-	if (!lru_list.first()) lru = 0;
+	while (lru_first && ((size == 0) || (s < size))) {
+
+		Chunk *cb = static_cast<Chunk *>(const_cast<Element *>(lru_first));
+
+		/* write back dirty chunk before evicting it */
+		if (cb->dirty())
+			cb->sync(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+
+		remove(cb);
+		cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+		s += sizeof(Chunk);
+	}
 
 	if (s < size) throw Block::Driver::Request_congestion();
 }
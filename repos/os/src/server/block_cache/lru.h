@@ -11,15 +11,45 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-#include <util/list.h>
-
 #include "chunk.h"
 
 struct Lru_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	/**
+	 * Element of the doubly-linked LRU list
+	 *
+	 * The links are mutable because chunks are also touched when being
+	 * read via a const reference.
+	 */
+	class Element
+	{
+		private:
+
+			friend struct Lru_policy;
+
+			Element mutable *_prev   = nullptr;
+			Element mutable *_next   = nullptr;
+			bool    mutable  _listed = false;
+
+			/*
+			 * Noncopyable
+			 */
+			Element(Element const &);
+			Element &operator = (Element const &);
 
-	static void read(const Element  *e);
-	static void write(const Element *e);
+		public:
+
+			Element() { }
+	};
+
+	static void access(const Element *e);
+
+	static void read(const Element  *e) { access(e); }
+	static void write(const Element *e) { access(e); }
 	static void flush(Cache::size_t size = 0);
+
+	/**
+	 * Remove element from the LRU list, e.g., when a chunk gets destructed
+	 */
+	static void remove(const Element *e);
 };
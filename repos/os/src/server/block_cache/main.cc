@@ -12,6 +12,7 @@
  */
 
 #include <base/component.h>
+#include <base/attached_rom_dataspace.h>
 
 #include "lru.h"
 #include "driver.h"
@@ -24,24 +25,14 @@ static Driver<Policy> * driver = nullptr;
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *src)
 {
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
 
 	if (!driver) throw Write_failed(off);
 
-	if (!driver->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(driver->blk()->alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
-		driver->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	driver->_write_back_chunk(off, src);
 }
 
 
@@ -50,14 +41,16 @@ struct Main
 	template <typename T>
 	struct Factory : Block::Driver_factory
 	{
-		Genode::Env  &env;
-		Genode::Heap &heap;
+		Genode::Env          &env;
+		Genode::Heap         &heap;
+		Genode::size_t const  read_ahead;
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		Factory(Genode::Env &env, Genode::Heap &heap, Genode::size_t read_ahead)
+		: env(env), heap(heap), read_ahead(read_ahead) {}
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
+			driver = new (&heap) ::Driver<T>(env, heap, read_ahead);
 			return driver;
 		}
 
@@ -67,13 +60,20 @@ struct Main
 
 	void resource_handler() { }
 
-	Genode::Env                 &env;
-	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
-	Genode::Signal_handler<Main> resource_dispatcher {
+	Genode::Env                    &env;
+	Genode::Attached_rom_dataspace  config  { env, "config" };
+	Genode::Heap                    heap    { env.ram(), env.rm() };
+	Factory<Lru_policy>             factory { env, heap, read_ahead() };
+	Block::Root                     root    { env.ep(), heap, env.rm(), factory, true };
+	Genode::Signal_handler<Main>    resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
+	Genode::size_t read_ahead()
+	{
+		return config.xml().attribute_value("read_ahead",
+		                                    Genode::Number_of_bytes(0));
+	}
+
 	Main(Genode::Env &env) : env(env)
 	{
 		env.parent().announce(env.ep().manage(root));
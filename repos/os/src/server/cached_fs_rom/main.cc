@@ -19,6 +19,7 @@
 #include <region_map/client.h>
 #include <rm_session/connection.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
 #include <base/session_label.h>
 #include <base/heap.h>
 #include <base/component.h>
@@ -83,11 +84,23 @@ struct Cached_fs_rom::Cached_rom final
 
 	Transfer *transfer = nullptr;
 
+	/**
+	 * Set if the transfer of the content failed
+	 *
+	 * The partially read content is never handed out.
+	 */
+	bool failed = false;
+
 	/**
 	 * Reference count of cache entry
 	 */
 	int _ref_count = 0;
 
+	/**
+	 * Point in time of the last use, used for LRU eviction
+	 */
+	unsigned long last_use = 0;
+
 	Cached_rom(Cache_space   &cache_space,
 	           Env           &env,
 	           Rm_connection &rm,
@@ -144,6 +157,18 @@ struct Cached_fs_rom::Cached_rom final
 
 struct Cached_fs_rom::Transfer final
 {
+	public:
+
+		enum { MAX_QUEUE_DEPTH = 8 };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Transfer(Transfer const &);
+		Transfer &operator = (Transfer const &);
+
 		Cached_rom                    &_cached_rom;
 		Cached_rom::Guard              _cache_guard { _cached_rom };
 
@@ -151,84 +176,150 @@ struct Cached_fs_rom::Transfer final
 		File_system::File_handle       _handle;
 
 		File_system::file_size_t const _size;
-		File_system::seek_off_t        _seek = 0;
-		File_system::Packet_descriptor _raw_pkt = _alloc_packet();
-		File_system::Packet_guard      _packet_guard { *_fs.tx(), _raw_pkt };
+		size_t                   const _chunk_size =
+			min((size_t)_size, _fs.tx()->bulk_buffer_size()/8);
 
-		Transfer_space::Element        _transfer_elem;
+		File_system::seek_off_t        _seek     = 0; /* next chunk to request */
+		File_system::file_size_t       _received = 0;
+		bool                           _failed   = false;
 
-		/**
-		 * Allocate space in the File_system packet buffer
-		 *
-		 * \throw  Packet_alloc_failed
+		/*
+		 * Packet buffers, each used for one read request in flight
 		 */
-		File_system::Packet_descriptor _alloc_packet()
-		{
-			if (!_fs.tx()->ready_to_submit())
-				throw Packet_alloc_failed();
+		File_system::Packet_descriptor _packets[MAX_QUEUE_DEPTH] { };
+		unsigned                       _num_packets = 0;
+		unsigned                       _in_flight   = 0;
 
-			size_t chunk_size = min(_size, _fs.tx()->bulk_buffer_size()/4);
-			return _fs.tx()->alloc_packet(chunk_size);
-		}
+		Transfer_space::Element        _transfer_elem;
 
-		void _submit_next_packet()
+		void _submit(File_system::Packet_descriptor const &raw_pkt,
+		             File_system::seek_off_t pos, size_t length)
 		{
-			using namespace File_system;
-
 			File_system::Packet_descriptor
-			packet(_raw_pkt, _handle,
+			packet(raw_pkt, _handle,
 			       File_system::Packet_descriptor::READ,
-			       _raw_pkt.size(), _seek);
+			       length, pos);
 
 			_fs.tx()->submit_packet(packet);
+			_in_flight++;
+		}
+
+		/**
+		 * Request the next chunk of the file using the given packet buffer
+		 */
+		void _request_next_chunk(File_system::Packet_descriptor const &raw_pkt)
+		{
+			if (_failed || _seek >= _size)
+				return;
+
+			size_t const length = min(_chunk_size, (size_t)(_size - _seek));
+			_submit(raw_pkt, _seek, length);
+			_seek += length;
 		}
 
 	public:
 
 		/**
 		 * Constructor
+		 *
+		 * \param max_packets  maximum number of read requests in flight
+		 *
+		 * \throw Packet_alloc_failed
 		 */
 		Transfer(Transfer_space           &space,
 		         Cached_rom               &rom,
 		         File_system::Session     &fs,
 		         File_system::File_handle  file_handle,
-		         size_t                    file_size)
+		         size_t                    file_size,
+		         unsigned                  max_packets)
 		:
 			_cached_rom(rom), _fs(fs),
 			_handle(file_handle), _size(file_size),
 			_transfer_elem(*this, space, Transfer_space::Id{_handle.value})
 		{
+			Tx_source &source = *_fs.tx();
+
+			if (!source.ready_to_submit())
+				throw Packet_alloc_failed();
+
+			max_packets = min(max_packets, (unsigned)MAX_QUEUE_DEPTH);
+
+			/* the first packet is mandatory, additional packets are optional */
+			_packets[_num_packets++] = source.alloc_packet(_chunk_size);
+			try {
+				while (_num_packets < max_packets
+				    && _num_packets*_chunk_size < _size)
+					_packets[_num_packets++] = source.alloc_packet(_chunk_size);
+			} catch (Packet_alloc_failed) { }
+
 			_cached_rom.transfer = this;
 
-			_submit_next_packet();
+			for (unsigned i = 0; i < _num_packets; i++)
+				_request_next_chunk(_packets[i]);
+		}
+
+		~Transfer()
+		{
+			for (unsigned i = 0; i < _num_packets; i++)
+				_fs.tx()->release_packet(_packets[i]);
+
+			_fs.close(_handle);
+
+			_cached_rom.transfer = nullptr;
 		}
 
 		Path const &path() const { return _cached_rom.path; }
 
-		bool completed() const { return (_seek >= _size); }
+		unsigned num_packets() const { return _num_packets; }
+
+		bool completed() const
+		{
+			return !_in_flight && (_failed || _received >= _size);
+		}
 
 		/**
 		 * Called from the packet signal handler.
 		 */
 		void process_packet(File_system::Packet_descriptor const packet)
 		{
-			auto const pkt_seek = packet.position();
+			_in_flight--;
+
+			File_system::seek_off_t const pos = packet.position();
+
+			/* end of the chunk the packet belongs to */
+			File_system::seek_off_t const chunk_end =
+				min((File_system::seek_off_t)_size,
+				    (pos/_chunk_size + 1)*_chunk_size);
+
+			size_t const n = pos < chunk_end
+			               ? min(packet.length(), (size_t)(chunk_end - pos)) : 0;
+
+			if (!packet.succeeded() || n == 0) {
+
+				if (!_failed)
+					error("failed to read ", path(), " at offset ", pos);
+				_failed = true;
 
-			if (pkt_seek > _seek || _seek >= _size) {
-				error("bad packet seek position for ", path());
-				error("packet seek is ", packet.position(), ", file seek is ", _seek, ", file size is ", _size);
-				_seek = _size;
 			} else {
-				size_t const n = min(packet.length(), _size - pkt_seek);
-				memcpy(_cached_rom.ram_ds.local_addr<char>()+pkt_seek,
+
+				memcpy(_cached_rom.ram_ds.local_addr<char>()+pos,
 				       _fs.tx()->packet_content(packet), n);
-				_seek = pkt_seek+n;
+				_received += n;
+
+				/* request the remainder of a short read, or the next chunk */
+				if (pos + n < chunk_end)
+					_submit(packet, pos + n, chunk_end - (pos + n));
+				else
+					_request_next_chunk(packet);
 			}
 
-			if (completed())
-					_cached_rom.complete();
+			if (!completed())
+				return;
+
+			if (_failed)
+				_cached_rom.failed = true;
 			else
-				_submit_next_packet();
+				_cached_rom.complete();
 		}
 };
 
@@ -279,8 +370,36 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 
 	Heap heap { env.pd(), env.rm() };
 
+	/*
+	 * The configuration is optional
+	 */
+	Constructible<Attached_rom_dataspace> config { };
+
+	Xml_node config_xml()
+	{
+		if (!config.constructed())
+			try { config.construct(env, "config"); } catch (...) { }
+
+		return config.constructed() ? config->xml() : Xml_node("<config/>");
+	}
+
+	/* number of read requests in flight per transfer */
+	unsigned const queue_depth =
+		config_xml().attribute_value("queue_depth", 4U);
+
+	size_t const fs_buffer_size =
+		config_xml().attribute_value("buffer_size",
+		                             Number_of_bytes(File_system::DEFAULT_TX_BUF_SIZE));
+
 	Allocator_avl           fs_tx_block_alloc { &heap };
-	File_system::Connection fs { env, fs_tx_block_alloc };
+	File_system::Connection fs { env, fs_tx_block_alloc, "", "/", true,
+	                             fs_buffer_size };
+
+	/* packets of the file-system session held by transfers */
+	unsigned packets_in_use = 0;
+
+	/* counter used as clock for LRU eviction */
+	unsigned long use_count = 0;
 
 	Session_requests_rom session_requests { env, *this };
 
@@ -289,13 +408,17 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 
 	/**
 	 * Return true when a cache element is freed
+	 *
+	 * The least recently used element without sessions is evicted.
 	 */
 	bool cache_evict()
 	{
 		Cached_rom *discard = nullptr;
 
 		cache.for_each<Cached_rom&>([&] (Cached_rom &rom) {
-			if (!discard && rom.unused()) discard = &rom; });
+			if (rom.unused() && !rom.transfer
+			 && (!discard || rom.last_use < discard->last_use))
+				discard = &rom; });
 
 		if (discard)
 			destroy(heap, discard);
@@ -337,6 +460,83 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 		throw Service_denied();
 	}
 
+	/**
+	 * Start loading the file content of a cache entry
+	 *
+	 * \return false if the transfer must be deferred
+	 */
+	bool start_transfer(Cached_rom &rom)
+	{
+		unsigned const budget = File_system::Session::TX_QUEUE_SIZE - packets_in_use;
+		if (!budget)
+			return false;
+
+		File_system::File_handle handle = try_open(rom.path);
+
+		try {
+			Transfer &transfer = *new (heap)
+				Transfer(transfers, rom, fs, handle, rom.file_size,
+				         min(queue_depth, budget));
+			packets_in_use += transfer.num_packets();
+			return true;
+		}
+		catch (...) {
+			fs.close(handle);
+			return false;
+		}
+	}
+
+	/**
+	 * Load the ROMs listed in the '<prefetch>' configuration in advance
+	 *
+	 * Prefetched ROMs do not evict other cache entries. They are subject to
+	 * eviction as long as they are not used.
+	 */
+	void prefetch()
+	{
+		enum { MAX_PREFETCH_TRANSFERS = 2, RAM_RESERVE = 1024*1024 };
+
+		unsigned num_transfers = 0;
+		cache.for_each<Cached_rom&>([&] (Cached_rom &rom) {
+			if (rom.transfer) num_transfers++; });
+
+		config_xml().with_sub_node("prefetch", [&] (Xml_node const &prefetch) {
+			prefetch.for_each_sub_node("rom", [&] (Xml_node const &node) {
+
+				if (num_transfers >= MAX_PREFETCH_TRANSFERS)
+					return;
+
+				Path const path(node.attribute_value("name", String<File_system::MAX_PATH_LEN>()).string());
+
+				Cached_rom *rom = nullptr;
+				cache.for_each<Cached_rom&>([&] (Cached_rom &other) {
+					if (!rom && other.path == path)
+						rom = &other; });
+
+				try {
+					if (!rom) {
+						File_system::File_handle handle = open(path);
+						File_system::Handle_guard guard(fs, handle);
+						size_t const file_size = fs.status(handle).size;
+
+						if (env.pd().avail_ram().value < file_size + RAM_RESERVE
+						 || env.pd().avail_caps().value < 8)
+							return;
+
+						rom = new (heap) Cached_rom(cache, env, rm, path, file_size);
+					}
+
+					if (rom->completed() || rom->transfer || rom->failed)
+						return;
+
+					if (start_transfer(*rom))
+						num_transfers++;
+				}
+				catch (...) { warning("failed to prefetch ", path); }
+			});
+		});
+	}
+
 	/**
 	 * Create new sessions
 	 */
@@ -390,6 +590,18 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 			rom = new (heap) Cached_rom(cache, env, rm, path, file_size);
 		}
 
+		/*
+		 * Deny the requests that waited for a failed transfer. The entry is
+		 * discarded so that later requests retry the transfer.
+		 */
+		if (rom->failed) {
+			if (rom->unused())
+				destroy(heap, rom);
+			throw Service_denied();
+		}
+
+		rom->last_use = ++use_count;
+
 		if (rom->completed()) {
 			/* Create new RPC object */
 			Session_component *session = new (heap)
@@ -399,14 +611,9 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 			env.parent().deliver_session_cap(pid, env.ep().manage(*session));
 
 		} else if (!rom->transfer) {
-			File_system::File_handle handle = try_open(path);
 
-			try {
-				new (heap) Transfer(transfers, *rom, fs, handle, rom->file_size);
-			}
-			catch (...) {
+			if (!start_transfer(*rom)) {
 				Genode::warning("defer transfer of ", rom->path);
-				fs.close(handle);
 				/* retry when next pending transfer completes */
 				return;
 			}
@@ -429,6 +636,8 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 	{
 		Tx_source &source = *fs.tx();
 
+		bool transfer_completed = false;
+
 		while (source.ack_avail()) {
 			File_system::Packet_descriptor pkt = source.get_acked_packet();
 			if (pkt.operation() != File_system::Packet_descriptor::READ) continue;
@@ -442,7 +651,9 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 				transfer.process_packet(pkt);
 				if (transfer.completed()) {
 					session_requests.schedule();
+					packets_in_use -= transfer.num_packets();
 					destroy(heap, &transfer);
+					transfer_completed = true;
 				}
 				stray_pkt = false;
 			});
@@ -450,6 +661,9 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 			if (stray_pkt)
 				source.release_packet(pkt);
 		}
+
+		if (transfer_completed)
+			prefetch();
 	}
 
 	Main(Genode::Env &env) : env(env)
@@ -458,6 +672,8 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 
 		/* process any requests that have already queued */
 		session_requests.schedule();
+
+		prefetch();
 	}
 };
 
@@ -18,6 +18,7 @@
 #include <file_system/util.h>
 #include <os/path.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
 #include <root/component.h>
 #include <base/component.h>
 #include <base/session_label.h>
@@ -85,6 +86,32 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		 */
 		File_system::seek_off_t _file_seek = 0;
 
+		/**
+		 * Maximum number of read requests in flight
+		 */
+		unsigned const _queue_depth;
+
+		enum { MAX_QUEUE_DEPTH = 16 };
+
+		/*
+		 * State of the pipelined read of the file content
+		 *
+		 * The file is read in chunks of equal size. If a request returns
+		 * less data than requested, the remainder of the chunk is
+		 * requested again.
+		 */
+		struct Read_range
+		{
+			File_system::seek_off_t pos;
+			size_t                  length;
+		};
+
+		size_t     _chunk_size      = 0;
+		unsigned   _reads_in_flight = 0;
+		bool       _read_failed     = false;
+		unsigned   _num_retries     = 0;
+		Read_range _retries[MAX_QUEUE_DEPTH] { };
+
 		/**
 		 * Dataspace exposed as ROM module to the client
 		 */
@@ -265,31 +292,70 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 			if (_file_size == 0)
 				return false;
 
-			/* read content from file */
+			/*
+			 * Read content from file with up to '_queue_depth' requests in
+			 * flight, which share half of the packet buffer
+			 */
 			Tx_source &source = *_fs.tx();
-			while (_file_seek < _file_size) {
-				/* if we cannot submit then process acknowledgements */
-				while (!source.ready_to_submit())
-					_env.ep().wait_and_dispatch_one_io_signal();
 
-				size_t chunk_size = min(_file_size - _file_seek,
-				                        source.bulk_buffer_size() / 2);
+			_chunk_size      = max((size_t)1, source.bulk_buffer_size() / 2 / _queue_depth);
+			_reads_in_flight = 0;
+			_read_failed     = false;
+			_num_retries     = 0;
+
+			for (;;) {
+
+				while (!_read_failed && _reads_in_flight < _queue_depth
+				    && source.ready_to_submit()) {
+
+					Read_range range { 0, 0 };
+					if (_num_retries)
+						range = _retries[--_num_retries];
+					else if (_file_seek < _file_size)
+						range = { _file_seek, min((size_t)(_file_size - _file_seek),
+						                          _chunk_size) };
+					else
+						break;
+
+					File_system::Packet_descriptor raw_packet;
+					try { raw_packet = source.alloc_packet(range.length); }
+					catch (Tx_source::Packet_alloc_failed) {
+						if (range.pos != _file_seek)
+							_retries[_num_retries++] = range;
+
+						/* wait for the release of packets in flight */
+						if (_reads_in_flight)
+							break;
+						throw;
+					}
 
-				File_system::Packet_descriptor
-					packet(source.alloc_packet(chunk_size), _file_handle,
-					       File_system::Packet_descriptor::READ,
-					       chunk_size, _file_seek);
+					if (range.pos == _file_seek)
+						_file_seek += range.length;
 
-				source.submit_packet(packet);
+					source.submit_packet(File_system::Packet_descriptor(
+						raw_packet, _file_handle, File_system::Packet_descriptor::READ,
+						range.length, range.pos));
+					_reads_in_flight++;
+				}
 
-				/*
-				 * Process the global signal handler until we got a response
-				 * for the read request (indicated by a change of the seek
-				 * position).
-				 */
-				size_t const orig_file_seek = _file_seek;
-				while (_file_seek == orig_file_seek)
-					_env.ep().wait_and_dispatch_one_io_signal();
+				bool const done = !_reads_in_flight
+				               && (_read_failed || (!_num_retries && _file_seek >= _file_size));
+				if (done)
+					break;
+
+				/* process acknowledgements */
+				_env.ep().wait_and_dispatch_one_io_signal();
+			}
+
+			/*
+			 * Never hand out partially read content. The version stays
+			 * outdated so that the next 'dataspace' or 'update' call
+			 * retries the read.
+			 */
+			if (_read_failed) {
+				memset(_file_ds.local_addr<char>(), 0x00, _file_ds.size());
+				_file_size = 0;
+				return false;
 			}
 
 			_handed_out_version = _curr_version;
@@ -350,6 +416,7 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		 *
 		 * \param fs        file-system session to read the file from
 		 * \param filename  requested file name
+		 * \param queue_depth  maximum number of read requests in flight
 		 * \param sig_rec   signal receiver used to get notified about changes
 		 *                  within the compound directory (in the case when
 		 *                  the requested file could not be found at session-
@@ -358,10 +425,12 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		Rom_session_component(Env &env,
 		                      Sessions &sessions,
 		                      File_system::Session &fs,
-		                      const char *file_path)
+		                      const char *file_path,
+		                      unsigned queue_depth)
 		:
 			_env(env), _sessions(sessions), _fs(fs),
 			_file_path(file_path),
+			_queue_depth(max(1U, min(queue_depth, (unsigned)MAX_QUEUE_DEPTH))),
 			_file_ds(env.ram(), env.rm(), 0) /* realloc later */
 		{
 			try { _open_watch_handle(); }
@@ -448,17 +517,31 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 				if (!(packet.handle() == _file_handle))
 					return;
 
-				if (packet.position() > _file_seek || _file_seek >= _file_size) {
-					error("bad packet seek position");
-					_file_ds.realloc(&_env.ram(), 0);
-					_file_seek = 0;
+				_reads_in_flight--;
+
+				File_system::seek_off_t const pos = packet.position();
+
+				/* end of the chunk the packet belongs to */
+				File_system::seek_off_t const chunk_end =
+					min((File_system::seek_off_t)_file_size,
+					    (pos/_chunk_size + 1)*_chunk_size);
+
+				size_t const n = pos < chunk_end
+				               ? min(packet.length(), (size_t)(chunk_end - pos)) : 0;
+
+				if (!packet.succeeded() || n == 0) {
+					if (!_read_failed)
+						error("failed to read ", _file_path, " at offset ", pos);
+					_read_failed = true;
 					return;
 				}
 
-				size_t const n = min(packet.length(), _file_size - _file_seek);
-				memcpy(_file_ds.local_addr<char>()+_file_seek,
+				memcpy(_file_ds.local_addr<char>() + pos,
 				       _fs.tx()->packet_content(packet), n);
-				_file_seek += n;
+
+				/* request the remainder of a short read again */
+				if (pos + n < chunk_end && _num_retries < MAX_QUEUE_DEPTH)
+					_retries[_num_retries++] = { pos + n, (size_t)(chunk_end - pos - n) };
 				return;
 			}
 
@@ -487,10 +570,31 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 		Heap          _heap { _env.ram(), _env.rm() };
 		Sessions    _sessions { };
 
+		/*
+		 * The configuration is optional
+		 */
+		Constructible<Attached_rom_dataspace> _config { };
+
+		Xml_node _config_xml()
+		{
+			if (!_config.constructed())
+				try { _config.construct(_env, "config"); } catch (...) { }
+
+			return _config.constructed() ? _config->xml() : Xml_node("<config/>");
+		}
+
+		unsigned const _queue_depth =
+			_config_xml().attribute_value("queue_depth", 4U);
+
+		size_t const _fs_buffer_size =
+			_config_xml().attribute_value("buffer_size",
+			                              Number_of_bytes(File_system::DEFAULT_TX_BUF_SIZE));
+
 		Allocator_avl _fs_tx_block_alloc { &_heap };
 
 		/* open file-system session */
-		File_system::Connection _fs { _env, _fs_tx_block_alloc };
+		File_system::Connection _fs { _env, _fs_tx_block_alloc, "", "/", true,
+		                              _fs_buffer_size };
 
 		Io_signal_handler<Rom_root> _packet_handler {
 			_env.ep(), *this, &Rom_root::_handle_packets };
@@ -524,7 +628,8 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 
 			/* create new session for the requested file */
 			return new (md_alloc())
-				Rom_session_component(_env, _sessions, _fs, module_name.string());
+				Rom_session_component(_env, _sessions, _fs, module_name.string(),
+				                      _queue_depth);
 		}
 
 	public:
@@ -477,6 +477,7 @@ Interface::_new_link(L3_protocol             const  protocol,
 		}
 		catch (Out_of_ram)  { throw Free_resources_and_retry_handle_eth(L3_protocol::TCP); }
 		catch (Out_of_caps) { throw Free_resources_and_retry_handle_eth(L3_protocol::TCP); }
+		catch (Link_side_table::Full) { _link_table_full(remote_port_alloc, remote); }
 
 		break;
 	case L3_protocol::UDP:
@@ -487,6 +488,7 @@ Interface::_new_link(L3_protocol             const  protocol,
 		}
 		catch (Out_of_ram)  { throw Free_resources_and_retry_handle_eth(L3_protocol::UDP); }
 		catch (Out_of_caps) { throw Free_resources_and_retry_handle_eth(L3_protocol::UDP); }
+		catch (Link_side_table::Full) { _link_table_full(remote_port_alloc, remote); }
 
 		break;
 	case L3_protocol::ICMP:
@@ -497,12 +499,23 @@ Interface::_new_link(L3_protocol             const  protocol,
 		}
 		catch (Out_of_ram)  { throw Free_resources_and_retry_handle_eth(L3_protocol::ICMP); }
 		catch (Out_of_caps) { throw Free_resources_and_retry_handle_eth(L3_protocol::ICMP); }
+		catch (Link_side_table::Full) { _link_table_full(remote_port_alloc, remote); }
 
 		break;
 	default: throw Bad_transport_protocol(); }
 }
 
 
+void Interface::_link_table_full(Pointer<Port_allocator_guard>        remote_port_alloc,
+                                 Link_side_id                  const &remote_id)
+{
+	try { remote_port_alloc().free(remote_id.dst_port); }
+	catch (Pointer<Port_allocator_guard>::Invalid) { }
+
+	throw Drop_packet("link table full");
+}
+
+
 void Interface::dhcp_allocation_expired(Dhcp_allocation &allocation)
 {
 	_release_dhcp_allocation(allocation, _domain());
@@ -967,7 +980,7 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 		_link_packet(prot, prot_base, link, client);
 		return;
 	}
-	catch (Link_side_tree::No_match) { }
+	catch (Link_side_table::No_match) { }
 
 	/* try to route via ICMP rules */
 	try {
@@ -1048,7 +1061,7 @@ void Interface::_handle_icmp_error(Ethernet_frame          &eth,
 			_link_packet(embed_prot, embed_prot_base, link, client); }
 	}
 	/* drop packet if there is no matching link */
-	catch (Link_side_tree::No_match) {
+	catch (Link_side_table::No_match) {
 		throw Drop_packet("no link that matches packet embedded in ICMP error"); }
 }
 
@@ -1186,7 +1199,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			_link_packet(prot, prot_base, link, client);
 			return;
 		}
-		catch (Link_side_tree::No_match) { }
+		catch (Link_side_table::No_match) { }
 
 		/* try to route via forward rules */
 		if (local_id.dst_ip == local_intf.address) {
@@ -1476,8 +1489,16 @@ void Interface::_continue_handle_eth(Domain            const &domain,
 
 void Interface::_ready_to_ack()
 {
-	while (_source.ack_avail()) {
-		_source.release_packet(_source.get_acked_packet()); }
+	enum { MAX_ACKS_PER_BATCH = 32 };
+	Packet_descriptor acks[MAX_ACKS_PER_BATCH];
+
+	while (unsigned const num =
+	       _source.try_get_acked_packets(acks, MAX_ACKS_PER_BATCH)) {
+
+		for (unsigned i = 0; i < num; i++) {
+			_source.release_packet(acks[i]); }
+	}
+	_source.wakeup();
 }
 
 
@@ -1759,6 +1780,15 @@ void Interface::_update_link_check_nat(Link        &link,
 		_dismiss_link_log(link, "rule targets other domain");
 		throw Dismiss_link();
 	}
+	/* make room for the link sides before committing to the re-link */
+	try {
+		cln_dom.links(prot).reserve(2);
+		new_srv_dom.links(prot).reserve(2);
+	}
+	catch (Out_of_ram)  { _dismiss_link_log(link, "out of RAM");  throw Dismiss_link(); }
+	catch (Out_of_caps) { _dismiss_link_log(link, "out of CAPs"); throw Dismiss_link(); }
+	catch (Link_side_table::Full) { _dismiss_link_log(link, "link table full"); throw Dismiss_link(); }
+
 	Pointer<Port_allocator_guard> remote_port_alloc_ptr;
 	if (link.client().src_ip() == link.server().dst_ip()) {
 		link.handle_config(cln_dom, new_srv_dom, remote_port_alloc_ptr, _config());
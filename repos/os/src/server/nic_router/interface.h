@@ -166,6 +166,12 @@ class Net::Interface : private Interface_list::Element
 		               Domain                        &remote_domain,
 		               Link_side_id            const &remote_id);
 
+		/**
+		 * Release the NAT port of a link that did not fit and drop the packet
+		 */
+		void _link_table_full(Pointer<Port_allocator_guard>        remote_port_alloc,
+		                      Link_side_id                  const &remote_id);
+
 		void _destroy_released_dhcp_allocations(Domain &local_domain);
 
 		void _destroy_dhcp_allocation(Dhcp_allocation &allocation,
@@ -45,6 +45,19 @@ bool Link_side_id::operator > (Link_side_id const &id) const
 }
 
 
+uint32_t Link_side_id::hash() const
+{
+	/* FNV-1a */
+	uint8_t const *byte = (uint8_t const *)data_base();
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < data_size(); i++) {
+		hash ^= byte[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+
 /***************
  ** Link_side **
  ***************/
@@ -62,44 +75,204 @@ Link_side::Link_side(Domain             &domain,
 }
 
 
-Link_side const &Link_side::find_by_id(Link_side_id const &id) const
+void Link_side::print(Output &output) const
 {
-	if (id == _id) {
-		return *this; }
+	Genode::print(output, "src ", src_ip(), ":", src_port(),
+	                     " dst ", dst_ip(), ":", dst_port());
+}
 
-	bool const side = id > _id;
-	Link_side *const link_side = Avl_node<Link_side>::child(side);
-	if (!link_side) {
-		throw Link_side_tree::No_match(); }
 
-	return link_side->find_by_id(id);
+bool Link_side::is_client() const
+{
+	return this == &_link.client();
 }
 
 
-void Link_side::print(Output &output) const
+/*********************
+ ** Link_side_table **
+ *********************/
+
+Link_side_table::Slot const *
+Link_side_table::_find(Table const &table, Link_side_id const &id,
+                       uint32_t const hash)
 {
-	Genode::print(output, "src ", src_ip(), ":", src_port(),
-	                     " dst ", dst_ip(), ":", dst_port());
+	if (!table.capacity) {
+		return nullptr; }
+
+	size_t const mask = table.capacity - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+
+		Slot const &slot = table.slots[i];
+		if (!slot.side && !slot.removed) {
+			return nullptr; }
+
+		if (slot.side && slot.hash == hash && slot.side->_id == id) {
+			return &slot; }
+	}
 }
 
 
-bool Link_side::is_client() const
+bool Link_side_table::_remove(Table &table, Link_side &side)
 {
-	return this == &_link.client();
+	if (!table.capacity) {
+		return false; }
+
+	size_t const mask = table.capacity - 1;
+	for (size_t i = side._hash & mask; ; i = (i + 1) & mask) {
+
+		Slot &slot = table.slots[i];
+		if (!slot.side && !slot.removed) {
+			return false; }
+
+		if (slot.side == &side) {
+			slot = Slot { nullptr, 0, true };
+			table.live--;
+			return true;
+		}
+	}
 }
 
 
-/********************
- ** Link_side_tree **
- ********************/
+void Link_side_table::_insert(Table &table, Link_side &side)
+{
+	size_t const mask = table.capacity - 1;
+	for (size_t i = side._hash & mask; ; i = (i + 1) & mask) {
+
+		Slot &slot = table.slots[i];
+		if (slot.side) {
+			continue; }
+
+		if (!slot.removed) {
+			table.used++; }
+
+		slot = Slot { &side, side._hash, false };
+		table.live++;
+		return;
+	}
+}
 
-Link_side const &Link_side_tree::find_by_id(Link_side_id const &id) const
+
+void Link_side_table::_free(Table &table)
+{
+	if (table.slots) {
+		_alloc.free(table.slots, table.capacity * sizeof(Slot)); }
+
+	table = Table { };
+}
+
+
+void Link_side_table::_migrate(size_t steps)
 {
-	Link_side *const link_side = first();
-	if (!link_side) {
+	for (; steps && _migrated < _prev.capacity; steps--, _migrated++) {
+
+		Slot &slot = _prev.slots[_migrated];
+		if (!slot.side) {
+			continue; }
+
+		_insert(_curr, *slot.side);
+		slot = Slot { nullptr, 0, true };
+		_prev.live--;
+	}
+	/* the old table is dropped as soon as no entry is left */
+	if (_prev.capacity && (_migrated == _prev.capacity || !_prev.live)) {
+		_free(_prev);
+		_migrated = 0;
+	}
+}
+
+
+void Link_side_table::_resize(size_t const num)
+{
+	/* size new table for a load of at most 1/2 */
+	size_t const live = count() + num;
+	size_t capacity = INITIAL_CAPACITY;
+	while (capacity < 2 * live && capacity < MAX_CAPACITY) {
+		capacity *= 2; }
+
+	Table table { };
+	if (!_alloc.alloc(capacity * sizeof(Slot), (void **)&table.slots)) {
+		throw Out_of_ram(); }
+
+	table.capacity = capacity;
+	for (size_t i = 0; i < capacity; i++) {
+		table.slots[i] = Slot { nullptr, 0, false }; }
+
+	/* a pending migration is finished at once */
+	_migrate(~(size_t)0);
+
+	_prev     = _curr;
+	_curr     = table;
+	_migrated = 0;
+
+	/* drop the old table right away if it is empty */
+	_migrate(0);
+}
+
+
+void Link_side_table::_shrink()
+{
+	/* wait for pending migrations, the empty table is dropped eventually */
+	if (_prev.capacity || _curr.capacity <= INITIAL_CAPACITY ||
+	    8 * _curr.live >= _curr.capacity) {
+		return; }
+
+	/* keep the large table if there is no memory for a smaller one */
+	try { _resize(0); }
+	catch (Out_of_ram)  { }
+	catch (Out_of_caps) { }
+}
+
+
+Link_side_table::~Link_side_table()
+{
+	_free(_prev);
+	_free(_curr);
+}
+
+
+void Link_side_table::reserve(size_t const num)
+{
+	/* keep the load of the current table incl. pending migrations <= 3/4 */
+	if (4 * (_curr.used + _prev.live + num) <= 3 * _curr.capacity) {
+		return; }
+
+	if (4 * (count() + num) > 3 * (size_t)MAX_CAPACITY) {
+		throw Full(); }
+
+	_resize(num);
+}
+
+
+void Link_side_table::insert(Link_side &side)
+{
+	reserve(1);
+	_insert(_curr, side);
+	_migrate(MIGRATION_STEPS);
+}
+
+
+void Link_side_table::remove(Link_side &side)
+{
+	if (!_remove(_curr, side)) {
+		_remove(_prev, side); }
+
+	_migrate(MIGRATION_STEPS);
+	_shrink();
+}
+
+
+Link_side const &Link_side_table::find_by_id(Link_side_id const &id) const
+{
+	uint32_t const hash = id.hash();
+
+	Slot const *slot = _find(_curr, id, hash);
+	if (!slot) {
+		slot = _find(_prev, id, hash); }
+
+	if (!slot) {
 		throw No_match(); }
 
-	return link_side->find_by_id(id);
+	return *slot->side;
 }
 
 
@@ -135,10 +308,14 @@ Link::Link(Interface                     &cln_interface,
 	_stats(stats),
 	_stats_curr(stats.opening)
 {
+	/* make room for both link sides before modifying any state */
+	_client.domain().links(_protocol).reserve(2);
+	_server.domain().links(_protocol).reserve(2);
+
 	_stats_curr()++;
 	_client_interface.links(_protocol).insert(this);
-	_client.domain().links(_protocol).insert(&_client);
-	_server.domain().links(_protocol).insert(&_server);
+	_client.domain().links(_protocol).insert(_client);
+	_server.domain().links(_protocol).insert(_server);
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 }
 
@@ -168,8 +345,8 @@ void Link::dissolve(bool timeout)
 	}
 	_stats_curr()++;
 
-	_client.domain().links(_protocol).remove(&_client);
-	_server.domain().links(_protocol).remove(&_server);
+	_client.domain().links(_protocol).remove(_client);
+	_server.domain().links(_protocol).remove(_server);
 	if (_config().verbose()) {
 		log("Dissolve ", l3_protocol_name(_protocol), " link: ", *this); }
 
@@ -201,16 +378,16 @@ void Link::handle_config(Domain                        &cln_domain,
 	_dissolve_timeout_us = dissolve_timeout_us;
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 
-	_client.domain().links(_protocol).remove(&_client);
-	_server.domain().links(_protocol).remove(&_server);
+	_client.domain().links(_protocol).remove(_client);
+	_server.domain().links(_protocol).remove(_server);
 
 	_config            = config;
 	_client._domain    = cln_domain;
 	_server._domain    = srv_domain;
 	_server_port_alloc = srv_port_alloc;
 
-	cln_domain.links(_protocol).insert(&_client);
-	srv_domain.links(_protocol).insert(&_server);
+	cln_domain.links(_protocol).insert(_client);
+	srv_domain.links(_protocol).insert(_server);
 
 	if (config.verbose()) {
 		log("[", cln_domain, "] update link client: ", _client);
@@ -32,7 +32,6 @@
 
 /* Genode includes */
 #include <timer_session/connection.h>
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
@@ -53,7 +52,7 @@ namespace Net {
 	class  Interface;
 	class  Link_side_id;
 	class  Link_side;
-	class  Link_side_tree;
+	class  Link_side_table;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -73,6 +72,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -85,15 +86,17 @@ struct Net::Link_side_id
 __attribute__((__packed__));
 
 
-class Net::Link_side : public Genode::Avl_node<Link_side>
+class Net::Link_side
 {
 	friend class Link;
+	friend class Link_side_table;
 
 	private:
 
-		Reference<Domain>   _domain;
-		Link_side_id const  _id;
-		Link               &_link;
+		Reference<Domain>        _domain;
+		Link_side_id     const   _id;
+		Genode::uint32_t const   _hash { _id.hash() };
+		Link                    &_link;
 
 	public:
 
@@ -101,18 +104,9 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		          Link_side_id const &id,
 		          Link               &link);
 
-		Link_side const &find_by_id(Link_side_id const &id) const;
-
 		bool is_client() const;
 
 
-		/**************
-		 ** Avl_node **
-		 **************/
-
-		bool higher(Link_side *side) { return side->_id > _id; }
-
-
 		/*********
 		 ** Log **
 		 *********/
@@ -133,11 +127,102 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 };
 
 
-struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
+/**
+ * Hash table of the link sides of a domain, keyed by their 5-tuple
+ *
+ * The table uses open addressing with linear probing. Each slot caches the
+ * hash of its link side so that a lookup usually touches the link side of
+ * the match only. When the table has to grow, the entries of the old table
+ * are migrated into the new one a few slots per insertion or removal, which
+ * avoids latency peaks at a high number of links. Lookups consult both
+ * tables until the migration is done. Once most links of a burst are gone,
+ * the table is replaced by a smaller one the same way.
+ *
+ * The tables are allocated from the router-global allocator and shared by
+ * all sessions of a domain. Their capacity is therefore bounded, which
+ * limits the number of links per domain and protocol.
+ */
+class Net::Link_side_table : Genode::Noncopyable
 {
-	struct No_match : Genode::Exception { };
+	public:
+
+		struct No_match : Genode::Exception { };
+		struct Full     : Genode::Exception { };
+
+	private:
+
+		enum {
+			INITIAL_CAPACITY = 64,
+			MAX_CAPACITY     = 64 * 1024,
+			MIGRATION_STEPS  = 8,
+		};
+
+		struct Slot
+		{
+			Link_side        *side;
+			Genode::uint32_t  hash;
+			bool              removed;
+		};
+
+		struct Table
+		{
+			Slot           *slots    { nullptr };
+			Genode::size_t  capacity { 0 };     /* power of two */
+			Genode::size_t  used     { 0 };     /* live and removed slots */
+			Genode::size_t  live     { 0 };
+		};
+
+		Genode::Allocator &_alloc;
+		Table              _curr     { };
+		Table              _prev     { };    /* table being migrated */
+		Genode::size_t     _migrated { 0 };  /* next slot of '_prev' */
+
+		static Slot const *_find(Table const &, Link_side_id const &,
+		                         Genode::uint32_t hash);
+
+		static bool _remove(Table &, Link_side &);
+
+		static void _insert(Table &, Link_side &);
+
+		void _free(Table &);
+
+		void _migrate(Genode::size_t steps);
+
+		/**
+		 * Replace the current table by one sized for 'num' more entries
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void _resize(Genode::size_t num);
+
+		/**
+		 * Replace a sparsely used table by a smaller one if possible
+		 */
+		void _shrink();
+
+	public:
+
+		Link_side_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Link_side_table();
+
+		/**
+		 * Ensure that 'num' link sides can be inserted without allocation
+		 *
+		 * \throw Full  the table reached its maximum capacity
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void reserve(Genode::size_t num);
+
+		void insert(Link_side &);
+
+		void remove(Link_side &);
+
+		Link_side const &find_by_id(Link_side_id const &id) const;
 
-	Link_side const &find_by_id(Link_side_id const &id) const;
+		Genode::size_t count() const { return _curr.live + _prev.live; }
 };
 
 
@@ -180,6 +265,12 @@ class Net::Link : public Link_list::Element
 
 		void dissolve(bool timeout);
 
+		/**
+		 * Move the link to the domains of a new configuration
+		 *
+		 * The caller must have reserved room for both link sides in the
+		 * link tables of 'cln_domain' and 'srv_domain'.
+		 */
 		void handle_config(Domain                        &cln_domain,
 		                   Domain                        &srv_domain,
 		                   Pointer<Port_allocator_guard>  srv_port_alloc,
@@ -129,16 +129,19 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 
 		long number() const { return _number; }
 
-		bool acknowledge(Request &request)
+		/**
+		 * Acknowledge the client requests of a completed job
+		 *
+		 * \return true if all requests of the job are acknowledged
+		 */
+		bool acknowledge(Job &job)
 		{
-			bool progress = false;
-			try_acknowledge([&] (Ack &ack) {
-				if (progress) return;
-				ack.submit(request);
-				progress = true;
-			});
+			Job::Batch const &batch = job.batch;
+
+			job.acked += try_acknowledge(batch.requests() + job.acked,
+			                             batch.count() - job.acked);
 
-			return progress;
+			return job.acked == batch.count();
 		}
 
 		void handle_requests() override
@@ -231,6 +234,59 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		Job_queue<128>       _job_queue { };
 		Registry<Block::Job> _job_registry { };
 
+		/*
+		 * Upper bound of the size of a merged job
+		 *
+		 * Larger jobs are split by the block connection anyway but would
+		 * occupy most of the I/O buffer.
+		 */
+		block_count_t const _max_batch_blocks =
+			max((size_t)1, (size_t)_io_buffer_size / 4 / _block.info().block_size);
+
+		/*
+		 * Batch of adjacent client requests not yet submitted as job
+		 *
+		 * Adjacent read or write requests of a session are collected while
+		 * the session's request queue is processed. The batch is turned
+		 * into a single job for the device on 'update'.
+		 */
+		struct Pending_batch
+		{
+			addr_t     index  { 0 };
+			long       number { -1 };
+			Job::Batch batch  { };
+			addr_t     addr[Job::MAX_REQUESTS] { };
+		};
+
+		Pending_batch _pending { };
+
+		void _submit_pending_batch()
+		{
+			if (_pending.batch.empty())
+				return;
+
+			Operation op     = _pending.batch.operation();
+			op.block_number += _partition_table.partition(_pending.number).lba;
+
+			_job_queue.with_job(_pending.index, [&](Job_object &job) {
+				job.construct(_block, op, _job_registry, _pending.index,
+				              _pending.number, _pending.batch, _pending.addr);
+			});
+
+			_pending.batch.reset();
+			_pending.number = -1;
+		}
+
+		void _drop_pending_batch(long number)
+		{
+			if (_pending.batch.empty() || _pending.number != number)
+				return;
+
+			_job_queue.free(_pending.index);
+			_pending.batch.reset();
+			_pending.number = -1;
+		}
+
 		unsigned _wake_up_index { 0 };
 
 		void _wakeup_clients()
@@ -248,7 +304,7 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 					_job_registry.for_each([&] (Job &job) {
 						if (in_flight || i == job.number) {
-							Operation &op = job.request.operation;
+							Operation const op = job.batch.operation();
 							in_flight |= (op.type == Operation::Type::WRITE ||
 							              op.type == Operation::Type::SYNC);
 						}
@@ -382,6 +438,8 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				if (!_sessions[number] || !(cap == _sessions[number]->cap()))
 					continue;
 
+				_drop_pending_batch(number);
+
 				destroy(_heap, _sessions[number]);
 				_sessions[number] = nullptr;
 
@@ -396,25 +454,42 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		 ** Update_jobs_policy **
 		 ************************/
 
-		void consume_read_result(Job &job, off_t,
+		/**
+		 * Call 'fn' with the client payload of each request covered by the
+		 * device range of 'length' bytes at 'offset'
+		 */
+		template <typename FN>
+		void _for_each_part(Job &job, off_t offset, size_t length, FN const &fn)
+		{
+			size_t const block_size = _block.info().block_size;
+			size_t const job_offset = offset - job.operation().block_number*block_size;
+
+			job.batch.for_each_part(block_size, job_offset, length,
+				[&] (unsigned i, size_t request_offset, size_t n) {
+					fn((void *)(job.addr[i] + request_offset), n); });
+		}
+
+		void consume_read_result(Job &job, off_t offset,
 		                         char const *src, size_t length)
 		{
 			if (!_sessions[job.number]) return;
 
-			memcpy((void *)(job.addr + job.offset), src, length);
-			job.offset += length;
+			_for_each_part(job, offset, length, [&] (void *ptr, size_t n) {
+				memcpy(ptr, src, n);
+				src += n; });
 		}
 
-		void produce_write_content(Job &job, off_t, char *dst, size_t length)
+		void produce_write_content(Job &job, off_t offset, char *dst, size_t length)
 		{
-			memcpy(dst, (void *)(job.addr + job.offset), length);
-			job.offset += length;
+			_for_each_part(job, offset, length, [&] (void const *ptr, size_t n) {
+				memcpy(dst, ptr, n);
+				dst += n; });
 		}
 
 		void completed(Job &job, bool success)
 		{
-			job.request.success = success;
-			job.completed       = true;
+			job.batch.succeeded(success);
+			job.completed = true;
 		}
 
 
@@ -422,7 +497,11 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		 ** Dispatch **
 		 **************/
 
-		void update() override { _block.update_jobs(*this); }
+		void update() override
+		{
+			_submit_pending_batch();
+			_block.update_jobs(*this);
+		}
 
 		Response submit(long number, Request const &request, addr_t addr) override
 		{
@@ -432,32 +511,46 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 			if (last > partition.sectors)
 				return Response::REJECTED;
 
+			/* merge request with the adjacent requests of the pending batch */
+			if (_pending.number == number
+			 && _pending.batch.try_append(request, _max_batch_blocks)) {
+				_pending.addr[_pending.batch.count() - 1] = addr;
+				return Response::ACCEPTED;
+			}
+
+			_submit_pending_batch();
+
 			addr_t index = 0;
 			try {
 				index  = _job_queue.alloc();
 			} catch (...) { return Response::RETRY; }
 
-			_job_queue.with_job(index, [&](Job_object &job) {
-
-				Operation op     = request.operation;
-				op.block_number += partition.lba;
-
-				job.construct(_block, op, _job_registry, index, number, request, addr);
-			});
+			_pending.index  = index;
+			_pending.number = number;
+			_pending.batch.try_append(request, _max_batch_blocks);
+			_pending.addr[0] = addr;
 
 			return Response::ACCEPTED;
 		}
 
 		Response sync(long number, Request const &request) override
 		{
+			/* preserve the order of the preceding requests */
+			_submit_pending_batch();
+
 			addr_t index = 0;
 			try {
 				index = _job_queue.alloc();
 			} catch (...) { return Response::RETRY; }
 
+			Job::Batch batch { };
+			batch.try_append(request, request.operation.count);
+
+			addr_t const addr[1] { 0 };
+
 			_job_queue.with_job(index, [&](Job_object &job) {
 				job.construct(_block, request.operation, _job_registry,
-				              index, number, request, 0);
+				              index, number, batch, addr);
 			});
 
 			return Response::ACCEPTED;
@@ -479,7 +572,7 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				if (!all && job.number != number)
 					return;
 
-				if (_sessions[job.number]->acknowledge(job.request))
+				if (_sessions[job.number]->acknowledge(job))
 					_job_queue.free(index);
 			});
 		}
@@ -19,6 +19,7 @@
 #include <base/log.h>
 #include <base/registry.h>
 #include <block_session/connection.h>
+#include <block/request_batch.h>
 #include <os/reporter.h>
 
 namespace Block {
@@ -42,25 +43,33 @@ struct Block::Partition
 
 struct Block::Job : public Block_connection::Job
 {
+	enum { MAX_REQUESTS = 32 };
+
+	typedef Request_batch<MAX_REQUESTS> Batch;
+
 	Registry<Job>::Element registry_element;
 
 	addr_t  const index;                /* job index */
 	long    const number;               /* parition number */
-	Request       request;
-	addr_t  const addr;                 /* target payload address */
+	Batch         batch;                /* client requests merged into the job */
+	addr_t        addr[MAX_REQUESTS] { }; /* payload address per request */
 	bool          completed { false };
-	off_t         offset { 0 };         /* current offset in payload for partial jobs */
+	unsigned      acked     { 0 };      /* number of acknowledged requests */
 
 	Job(Block_connection &connection,
 	    Operation         operation,
 	    Registry<Job>    &registry,
 	    addr_t const      index,
 	    addr_t const      number,
-	    Request           request,
-	    addr_t            addr)
+	    Batch const      &batch,
+	    addr_t const     *addr)
 	: Block_connection::Job(connection, operation),
 	  registry_element(registry, *this),
-	  index(index), number(number), request(request), addr(addr) { }
+	  index(index), number(number), batch(batch)
+	{
+		for (unsigned i = 0; i < batch.count(); i++)
+			this->addr[i] = addr[i];
+	}
 };
 
 
@@ -18,6 +18,7 @@
 #include <report_rom/report_service.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
+#include <rm_session/connection.h>
 
 /* local includes */
 #include "rom_registry.h"
@@ -32,12 +33,39 @@ struct Report_rom::Main
 
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
-
 	Genode::Attached_rom_dataspace config_rom { env, "config" };
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	/*
+	 * Share each report revision among all ROM clients instead of copying
+	 * the report into a private dataspace per client
+	 */
+	struct Shared_snapshots
+	{
+		Genode::Heap          heap;
+		Genode::Rm_connection rm_connection;
+
+		Rom::Snapshot_resources resources { heap, rm_connection };
+
+		Shared_snapshots(Genode::Env &env)
+		: heap(env.ram(), env.rm()), rm_connection(env) { }
+	};
+
+	Genode::Constructible<Shared_snapshots> shared_snapshots { };
+
+	Rom::Snapshot_resources *_init_shared_snapshots()
+	{
+		if (!config_rom.xml().attribute_value("shared_snapshots", false))
+			return nullptr;
+
+		shared_snapshots.construct(env);
+		return &shared_snapshots->resources;
+	}
+
+	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom,
+	                             _init_shared_snapshots() };
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
 	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
 
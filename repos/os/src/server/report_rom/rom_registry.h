@@ -25,10 +25,17 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Registry(Registry const &);
+		Registry &operator = (Registry const &);
+
 		Genode::Allocator              &_md_alloc;
 		Genode::Ram_allocator          &_ram;
 		Genode::Region_map             &_rm;
 		Genode::Attached_rom_dataspace &_config_rom;
+		Snapshot_resources             *_snapshots;
 
 		Module_list _modules { };
 
@@ -72,7 +79,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, name, _read_write_policy, _read_write_policy,
+				       _snapshots);
 
 			_modules.insert(module);
 			return *module;
@@ -133,11 +141,20 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param snapshots  resources for sharing each report revision among
+		 *                   all readers, or nullptr to hand out a private
+		 *                   copy to each reader
+		 */
 		Registry(Genode::Allocator &md_alloc,
 		         Genode::Ram_allocator &ram, Genode::Region_map &rm,
-		         Genode::Attached_rom_dataspace &config_rom)
+		         Genode::Attached_rom_dataspace &config_rom,
+		         Snapshot_resources *snapshots = nullptr)
 		:
-			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom)
+			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom),
+			_snapshots(snapshots)
 		{ }
 
 		Module &lookup(Writer &writer, Module::Name const &name) override
@@ -13,6 +13,32 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+/*
+ * By default, all sessions are served by the component's entrypoint using
+ * one VFS instance configured by the '<vfs>' node. Optionally, '<entrypoint>'
+ * nodes define additional entrypoints, each running in a thread of its own
+ * and owning a private VFS instance configured by the '<vfs>' sub node of
+ * the '<entrypoint>' node. A session policy selects the entrypoint of the
+ * matching sessions via the 'entrypoint' attribute:
+ *
+ * ! <config>
+ * !   <vfs> <ram/> </vfs>
+ * !   <entrypoint name="fat"> <vfs> <fatfs/> </vfs> </entrypoint>
+ * !   <policy label_prefix="backup" root="/" entrypoint="fat" writeable="yes"/>
+ * !   <policy label_prefix="" root="/" writeable="yes"/>
+ * ! </config>
+ *
+ * Locking model: Each entrypoint exclusively owns its VFS instance, its
+ * sessions, and the packet processing of those sessions. VFS plugins
+ * register their signal handlers at the entrypoint of the VFS instance.
+ * Hence, neither the VFS plugins nor the server state are accessed by more
+ * than one thread and no locking is needed. The only interactions between
+ * entrypoints are the creation, upgrade, and closing of sessions, which the
+ * root of the component's entrypoint forwards as RPCs to the root of the
+ * responsible entrypoint. A slow back end thereby stalls the sessions of its
+ * own entrypoint only.
+ */
+
 /* Genode includes */
 #include <base/component.h>
 #include <base/registry.h>
@@ -21,6 +47,7 @@
 #include <base/attached_rom_dataspace.h>
 #include <file_system_session/rpc_object.h>
 #include <root/component.h>
+#include <root/client.h>
 #include <os/session_policy.h>
 #include <vfs/simple_env.h>
 
@@ -36,9 +63,12 @@ namespace Vfs_server {
 	class Session_component;
 	class Vfs_env;
 	class Root;
+	class Worker;
+	class Root_dispatcher;
 
 	typedef Genode::Fifo<Session_component>         Session_queue;
 	typedef Genode::Entrypoint::Io_progress_handler Io_progress_handler;
+	typedef Genode::String<64>                      Entrypoint_name;
 
 	/**
 	 * Convenience utities for parsing quotas
@@ -743,13 +773,27 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 		Genode::Env &_env;
 
+		/* name of the entrypoint, invalid for the component's entrypoint */
+		Entrypoint_name const _ep_name;
+
 		Genode::Attached_rom_dataspace _config_rom { _env, "config" };
 
 		Genode::Xml_node vfs_config()
 		{
-			try { return _config_rom.xml().sub_node("vfs"); }
+			try {
+				Genode::Xml_node const config = _config_rom.xml();
+
+				if (!_ep_name.valid())
+					return config.sub_node("vfs");
+
+				for (Genode::Xml_node ep = config.sub_node("entrypoint"); ;
+				     ep = ep.next("entrypoint"))
+					if (ep.attribute_value("name", Entrypoint_name()) == _ep_name)
+						return ep.sub_node("vfs");
+			}
 			catch (...) {
-				Genode::error("VFS not configured");
+				Genode::error("VFS not configured",
+				              _ep_name.valid() ? " for entrypoint " : "", _ep_name);
 				_env.parent().exit(~0);
 				throw;
 			}
@@ -1005,14 +1049,238 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 	public:
 
-		Root(Genode::Env &env, Genode::Allocator &md_alloc)
+		/**
+		 * Constructor
+		 *
+		 * \param env      environment of the entrypoint serving the
+		 *                 sessions and the VFS instance
+		 * \param ep_name  name of the '<entrypoint>' config node, or
+		 *                 invalid for the component's entrypoint
+		 */
+		Root(Genode::Env &env, Genode::Allocator &md_alloc,
+		     Entrypoint_name const &ep_name)
 		:
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env)
+			_env(env), _ep_name(ep_name)
 		{
 			_env.ep().register_io_progress_handler(*this);
 			_config_rom.sigh(_config_handler);
-			env.parent().announce(env.ep().manage(*this));
+		}
+};
+
+
+/**
+ * Additional entrypoint with a private VFS instance
+ */
+class Vfs_server::Worker : private Genode::Env
+{
+	private:
+
+		Genode::Env &_env;
+
+		Entrypoint_name const _name;
+
+		enum { STACK_SIZE = 16*1024*sizeof(long) };
+
+		Genode::Entrypoint _ep;
+
+		/*
+		 * Constructed after '_ep' because the VFS plugins register their
+		 * signal handlers at the entrypoint returned by 'ep()'
+		 */
+		Root _root;
+
+		Genode::Root_client _root_client { _ep.manage(_root) };
+
+
+		/*****************
+		 ** Genode::Env **
+		 *****************/
+
+		using Parent_service = Genode::Parent::Service_name;
+		using Session_args   = Genode::Parent::Session_args;
+		using Upgrade_args   = Genode::Parent::Upgrade_args;
+		using Client_id      = Genode::Parent::Client::Id;
+
+		Genode::Parent     &parent() override { return _env.parent(); }
+		Genode::Cpu_session &cpu()   override { return _env.cpu(); }
+		Genode::Region_map &rm()     override { return _env.rm(); }
+		Genode::Pd_session &pd()     override { return _env.pd(); }
+		Genode::Entrypoint &ep()     override { return _ep; }
+
+		Genode::Cpu_session_capability cpu_session_cap() override { return _env.cpu_session_cap(); }
+		Genode::Pd_session_capability  pd_session_cap()  override { return _env.pd_session_cap(); }
+
+		Genode::Id_space<Genode::Parent::Client> &id_space() override {
+			return _env.id_space(); }
+
+		Genode::Session_capability session(Parent_service   const &name,
+		                                   Client_id               id,
+		                                   Session_args     const &args,
+		                                   Genode::Affinity const &affinity) override {
+			return _env.session(name, id, args, affinity); }
+
+		void upgrade(Client_id id, Upgrade_args const &args) override {
+			_env.upgrade(id, args); }
+
+		void close(Client_id id) override { _env.close(id); }
+
+		void exec_static_constructors() override { }
+
+		void reinit(Genode::Native_capability::Raw raw) override {
+			_env.reinit(raw); }
+
+		void reinit_main_thread(Genode::Capability<Genode::Region_map> &stack_area_rm) override {
+			_env.reinit_main_thread(stack_area_rm); }
+
+	public:
+
+		Worker(Genode::Env &env, Genode::Allocator &md_alloc,
+		       Entrypoint_name const &name, Genode::Affinity::Location location)
+		:
+			_env(env), _name(name),
+			_ep(env, STACK_SIZE, name.string(), location),
+			_root(*this, md_alloc, name)
+		{ }
+
+		~Worker() { _ep.dissolve(_root); }
+
+		Entrypoint_name const &name() const { return _name; }
+
+		/**
+		 * Root interface of the worker, each call is an RPC executed by
+		 * the worker's entrypoint
+		 */
+		Genode::Root &root() { return _root_client; }
+};
+
+
+/**
+ * Root that forwards session requests to the responsible entrypoint
+ */
+class Vfs_server::Root_dispatcher : public Genode::Rpc_object<Genode::Typed_root<::File_system::Session>>
+{
+	private:
+
+		Genode::Env       &_env;
+		Genode::Allocator &_md_alloc;
+
+		Genode::Attached_rom_dataspace _config_rom { _env, "config" };
+
+		/* root of the sessions served by the component's entrypoint */
+		Root &_root;
+
+		Genode::Registry<Genode::Registered<Worker> > _workers { };
+
+		Genode::Root &_root_for_session(Genode::Session_label const &label)
+		{
+			using namespace Genode;
+
+			_config_rom.update();
+
+			Session_policy const policy(label, _config_rom.xml());
+
+			Entrypoint_name const name =
+				policy.attribute_value("entrypoint", Entrypoint_name());
+
+			if (!name.valid())
+				return _root;
+
+			Genode::Root *root = nullptr;
+			_workers.for_each([&] (Worker &worker) {
+				if (worker.name() == name)
+					root = &worker.root(); });
+
+			if (!root) {
+				error("unknown entrypoint '", name, "' for '", label, "'");
+				throw Service_denied();
+			}
+			return *root;
+		}
+
+		/**
+		 * Apply functor to the root of each entrypoint
+		 */
+		template <typename FN>
+		void _for_each_root(FN const &fn)
+		{
+			fn(static_cast<Genode::Root &>(_root));
+			_workers.for_each([&] (Worker &worker) { fn(worker.root()); });
+		}
+
+	public:
+
+		Root_dispatcher(Genode::Env &env, Genode::Allocator &md_alloc, Root &root)
+		:
+			_env(env), _md_alloc(md_alloc), _root(root)
+		{
+			using namespace Genode;
+
+			Affinity::Space const space = _env.cpu().affinity_space();
+
+			/* place the workers at the CPUs following the main thread */
+			unsigned index = 0;
+			_config_rom.xml().for_each_sub_node("entrypoint", [&] (Xml_node const &node) {
+
+				Entrypoint_name const name =
+					node.attribute_value("name", Entrypoint_name());
+
+				if (!name.valid()) {
+					warning("ignoring entrypoint without name");
+					return;
+				}
+
+				Affinity::Location const location =
+					space.total() ? space.location_of_index(++index % space.total())
+					              : Affinity::Location();
+
+				new (_md_alloc)
+					Registered<Worker>(_workers, _env, _md_alloc, name, location);
+			});
+		}
+
+		~Root_dispatcher()
+		{
+			_workers.for_each([&] (Genode::Registered<Worker> &worker) {
+				destroy(_md_alloc, &worker); });
+		}
+
+		bool has_workers() const
+		{
+			bool result = false;
+			_workers.for_each([&] (Worker const &) { result = true; });
+			return result;
+		}
+
+
+		/********************
+		 ** Root interface **
+		 ********************/
+
+		Genode::Session_capability session(Session_args const &args,
+		                                   Genode::Affinity const &affinity) override
+		{
+			if (!args.valid_string()) throw Genode::Service_denied();
+
+			Genode::Session_label const label =
+				Genode::label_from_args(args.string());
+
+			return _root_for_session(label).session(args, affinity);
+		}
+
+		/*
+		 * The roots ignore capabilities of sessions they do not serve.
+		 */
+
+		void upgrade(Genode::Session_capability session,
+		             Upgrade_args const &args) override
+		{
+			_for_each_root([&] (Genode::Root &root) { root.upgrade(session, args); });
+		}
+
+		void close(Genode::Session_capability session) override
+		{
+			_for_each_root([&] (Genode::Root &root) { root.close(session); });
 		}
 };
 
@@ -1021,5 +1289,16 @@ void Component::construct(Genode::Env &env)
 {
 	static Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	static Vfs_server::Root root { env, sliced_heap };
+	static Vfs_server::Root root { env, sliced_heap, Vfs_server::Entrypoint_name() };
+
+	static Vfs_server::Root_dispatcher dispatcher { env, sliced_heap, root };
+
+	/*
+	 * Without additional entrypoints, sessions are directly served by the
+	 * root of the component's entrypoint.
+	 */
+	if (dispatcher.has_workers())
+		env.parent().announce(env.ep().manage(dispatcher));
+	else
+		env.parent().announce(env.ep().manage(root));
 }
@@ -0,0 +1,173 @@
+/*
+ * \brief  Benchmark of the allocation rate of the heap
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark allocates and frees blocks of various sizes in the patterns
+ * of session-heavy servers, which allocate and release small objects per
+ * request. Each pattern runs on a heap with size-class bins and on a plain
+ * heap. After each run, the heap's consumed quota must return to its
+ * initial value. The initial value is taken after a first allocation of
+ * the size under test, which accounts for the empty block each bin keeps.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <timer/stopwatch.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Timer::Stopwatch;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Stopwatch _stopwatch { _timer };
+
+	unsigned const _count = _config.xml().attribute_value("count", 100000U);
+
+	Heap _bin_heap   { _env.ram(), _env.rm() };
+	Heap _plain_heap { _env.ram(), _env.rm() };
+
+	/* array of block pointers, allocated from a separate heap */
+	Heap _array_heap { _env.ram(), _env.rm() };
+
+	void ** const _blocks = (void **)
+		static_cast<Allocator &>(_array_heap).alloc(_count*sizeof(void *));
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void _alloc(Heap &heap, unsigned i, size_t size)
+	{
+		if (!heap.alloc(size, &_blocks[i]))
+			throw Out_of_ram();
+	}
+
+	/**
+	 * Return true if the heap's consumed quota is back at 'consumed'
+	 */
+	static bool _check_consumed(Heap const &heap, size_t consumed)
+	{
+		if (heap.consumed() == consumed)
+			return true;
+
+		error("consumed quota ", heap.consumed(), " differs from ", consumed);
+		return false;
+	}
+
+	bool _bench(char const *name, Heap &heap, size_t const size)
+	{
+		/* let the bin keep its empty block before taking the reference */
+		_alloc(heap, 0, size);
+		heap.free(_blocks[0], size);
+
+		size_t const consumed = heap.consumed();
+
+		/* allocate all blocks, release them in reverse order */
+		uint64_t const alloc_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _count; i++)
+				_alloc(heap, i, size); });
+
+		uint64_t const free_us = _stopwatch.measure_us([&] {
+			for (unsigned i = _count; i > 0; i--)
+				heap.free(_blocks[i - 1], size); });
+
+		if (!_check_consumed(heap, consumed))
+			return false;
+
+		/* allocate and release single blocks, as done per request */
+		uint64_t const pair_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _count; i++) {
+				_alloc(heap, 0, size);
+				heap.free(_blocks[0], size);
+			}
+		});
+
+		if (!_check_consumed(heap, consumed))
+			return false;
+
+		/* replace random blocks of a populated heap */
+		unsigned const live = _count/2;
+		for (unsigned i = 0; i < live; i++)
+			_alloc(heap, i, size);
+
+		uint64_t const random_us = _stopwatch.measure_us([&] {
+			for (unsigned i = 0; i < _count; i++) {
+				unsigned const j = _random() % live;
+				heap.free(_blocks[j], size);
+				_alloc(heap, j, size);
+			}
+		});
+
+		for (unsigned i = 0; i < live; i++)
+			heap.free(_blocks[i], size);
+
+		if (!_check_consumed(heap, consumed))
+			return false;
+
+		log(name, " ", size, " bytes: ",
+		    "alloc ",  Stopwatch::rate(_count, alloc_us),  " ops/s, ",
+		    "free ",   Stopwatch::rate(_count, free_us),   " ops/s, ",
+		    "pair ",   Stopwatch::rate(_count, pair_us),   " ops/s, ",
+		    "random ", Stopwatch::rate(_count, random_us), " ops/s");
+
+		return true;
+	}
+
+	bool _run()
+	{
+		size_t const sizes[] = { 16, 24, 64, 100, 256, 512, 1024, 4096 };
+
+		for (size_t size : sizes)
+			if (!_bench("bins ", _bin_heap,   size)
+			 || !_bench("plain", _plain_heap, size))
+				return false;
+
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_bin_heap.enable_bins();
+
+		_env.parent().exit(_run() ? 0 : -1);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -46,6 +46,7 @@ class Main : public Nic_handler,
 		enum { SRC_PORT          = 50000 };
 		enum { FIRST_DST_PORT    = 49152 };
 		enum { LAST_DST_PORT     = 65535 };
+		enum { MAX_NUM_LINKS     = LAST_DST_PORT - 1024 + 1 };
 
 		Env                            &_env;
 		Attached_rom_dataspace          _config_rom  { _env, "config" };
@@ -63,11 +64,22 @@ class Main : public Nic_handler,
 		                                               _config.attribute_value("gateway",   Ipv4_address()),
 		                                               Ipv4_address() };
 		Protocol                 const  _protocol    { _config.attribute_value("protocol", Protocol::ICMP) };
-		Port                            _dst_port    { FIRST_DST_PORT };
+		unsigned                 const  _num_links   { _init_num_links() };
+		Port                     const  _first_port  { (uint16_t)(LAST_DST_PORT + 1 - _num_links) };
+		Port                            _dst_port    { _first_port };
 		size_t                          _ping_sz     { _init_ping_sz() };
+		Microseconds             const  _report_us   { 1000UL * 1000 * _config.attribute_value("report_period_sec", 0U) };
+		Constructible<Periodic_timeout> _report      { };
+		unsigned long                   _sent_pkts   { 0 };
 
 		size_t _init_ping_sz() const;
 
+		unsigned _init_num_links() const;
+
+		void _next_dst_port();
+
+		void _report_throughput(Duration);
+
 		void _handle_arp(Ethernet_frame &eth,
 		                 Size_guard     &size_guard);
 
@@ -119,6 +131,10 @@ Main::Main(Env &env) : _env(env)
 	if (_dst_ip == Ipv4_address()) {
 		throw Invalid_arguments(); }
 
+	/* periodically report the number of sent packets if requested */
+	if (_report_us.value) {
+		_report.construct(_timer, *this, &Main::_report_throughput, _report_us); }
+
 	/* if there is a static IP config, start sending pings periodically */
 	if (ip_config().valid) {
 		_period.construct(_timer, *this, &Main::_send_ping, _period_us); }
@@ -199,6 +215,37 @@ void Main::_handle_arp(Ethernet_frame &eth,
 }
 
 
+unsigned Main::_init_num_links() const
+{
+	unsigned const num_links =
+		_config.attribute_value("num_links",
+		                        (unsigned)(LAST_DST_PORT - FIRST_DST_PORT + 1));
+
+	if (!num_links || num_links > MAX_NUM_LINKS) {
+		throw Invalid_arguments(); }
+
+	return num_links;
+}
+
+
+void Main::_next_dst_port()
+{
+	if (_dst_port.value == LAST_DST_PORT) {
+		_dst_port = _first_port; }
+	else {
+		_dst_port.value++; }
+}
+
+
+void Main::_report_throughput(Duration)
+{
+	log("sent ", _sent_pkts * 1000 * 1000 / _report_us.value,
+	    " packets/s using ", _num_links, " links");
+
+	_sent_pkts = 0;
+}
+
+
 size_t Main::_init_ping_sz() const
 {
 	enum { IP_SZ = sizeof(Ethernet_frame) + sizeof(Ipv4_packet) };
@@ -309,10 +356,7 @@ void Main::_send_ping(Duration)
 						icmp.update_checksum(0);
 
 						/* prepare next ICMP ping */
-						if (_dst_port.value == LAST_DST_PORT) {
-							_dst_port.value = FIRST_DST_PORT; }
-						else {
-							_dst_port.value++; }
+						_next_dst_port();
 						break;
 					}
 				case Protocol::UDP:
@@ -331,10 +375,7 @@ void Main::_send_ping(Duration)
 						udp.update_checksum(ip.src(), ip.dst());
 
 						/* prepare next ping */
-						if (_dst_port.value == LAST_DST_PORT) {
-							_dst_port.value = FIRST_DST_PORT; }
-						else {
-							_dst_port.value++; }
+						_next_dst_port();
 						break;
 					}
 				case Protocol::TCP:
@@ -352,10 +393,7 @@ void Main::_send_ping(Duration)
 						tcp.update_checksum(ip.src(), ip.dst(), size_guard.head_size() - tcp_off);
 
 						/* prepare next ping */
-						if (_dst_port.value == LAST_DST_PORT) {
-							_dst_port.value = FIRST_DST_PORT; }
-						else {
-							_dst_port.value++; }
+						_next_dst_port();
 						break;
 					}
 				}
@@ -363,6 +401,7 @@ void Main::_send_ping(Duration)
 				ip.total_length(size_guard.head_size() - ip_off);
 				ip.update_checksum();
 			});
+			_sent_pkts++;
 		}
 	}
 	catch (Net::Packet_stream_source::Packet_alloc_failed) { }
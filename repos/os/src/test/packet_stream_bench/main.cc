@@ -0,0 +1,147 @@
+/*
+ * \brief  Benchmark of packet-descriptor throughput of packet streams
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Source and sink of a packet stream are instantiated within the same
+ * component, with signal handlers registered at both sides. Each round
+ * passes descriptors from the source to the sink and back, either one by
+ * one or in batches of the configured sizes, and measures the number of
+ * round trips per second.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/component.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/packet_stream.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	struct Main;
+	using namespace Genode;
+}
+
+
+struct Test::Main
+{
+	enum { QUEUE_SIZE = 256, MAX_BATCH = QUEUE_SIZE - 1 };
+
+	typedef Packet_stream_policy<Packet_descriptor, QUEUE_SIZE, QUEUE_SIZE, char>
+	        Policy;
+
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Timer::Connection       _timer  { _env };
+	Allocator_avl           _packet_alloc { &_heap };
+
+	Ram_dataspace_capability _ds { _env.ram().alloc(64*1024) };
+
+	Packet_stream_source<Policy> _source { _ds, _env.rm(), _packet_alloc };
+	Packet_stream_sink<Policy>   _sink   { _ds, _env.rm() };
+
+	void _handle_signal() { }
+
+	Signal_handler<Main> _handler { _env.ep(), *this, &Main::_handle_signal };
+
+	unsigned long const _descriptors {
+		_config.xml().attribute_value("descriptors", 1000000UL) };
+
+	Packet_descriptor _packets[MAX_BATCH];
+
+	void _report(char const *mode, unsigned batch, uint64_t duration_us)
+	{
+		log(mode, " batch=", batch, ": ", _descriptors, " descriptors in ",
+		    duration_us/1000, " ms (",
+		    duration_us ? _descriptors*1000*1000/duration_us : 0,
+		    " descriptors/s)");
+	}
+
+	void _single()
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned long i = 0; i < _descriptors; i++) {
+
+			_source.try_submit_packet(_packets[0]);
+			_source.wakeup();
+
+			Packet_descriptor const packet = _sink.try_get_packet();
+			_sink.try_ack_packet(packet);
+			_sink.wakeup();
+
+			_source.release_packet(_source.try_get_acked_packet());
+			_source.wakeup();
+		}
+
+		_report("single ", 1, _timer.elapsed_us() - start_us);
+	}
+
+	void _batched(unsigned batch)
+	{
+		Packet_descriptor received[MAX_BATCH];
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned long i = 0; i < _descriptors; i += batch) {
+
+			unsigned const submitted = _source.try_submit_packets(_packets, batch);
+			_source.wakeup();
+
+			unsigned const num = _sink.try_get_packets(received, submitted);
+			_sink.try_ack_packets(received, num);
+			_sink.wakeup();
+
+			unsigned const acked = _source.try_get_acked_packets(received, num);
+			for (unsigned j = 0; j < acked; j++)
+				_source.release_packet(received[j]);
+			_source.wakeup();
+		}
+
+		_report("batched", batch, _timer.elapsed_us() - start_us);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_source.register_sigh_packet_avail(_handler);
+		_source.register_sigh_ready_to_ack(_handler);
+		_sink.register_sigh_ack_avail(_handler);
+		_sink.register_sigh_ready_to_submit(_handler);
+
+		log("--- packet-stream benchmark ---");
+
+		_single();
+
+		_config.xml().for_each_sub_node("batch", [&] (Xml_node const &node) {
+			unsigned const size = node.attribute_value("size", 1U);
+			if (size && size <= MAX_BATCH)
+				_batched(size);
+			else
+				error("invalid batch size ", size);
+		});
+
+		log("--- packet-stream benchmark finished ---");
+	}
+
+	~Main() { _env.ram().free(_ds); }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,186 @@
+/*
+ * \brief  Throughput of the pixel kernels used by the nitpicker_gfx painters
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark operates on a 4K surface in RAM and compares the vectorized
+ * kernels with the scalar reference implementation. Before measuring, the
+ * results of each implementation are checked against the reference.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/attached_ram_dataspace.h>
+#include <timer_session/connection.h>
+#include <nitpicker_gfx/box_painter.h>
+#include <nitpicker_gfx/texture_painter.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum { W = 3840, H = 2160, PIXELS = W*H, DURATION_MS = 1000 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _dst_ds   { _env.ram(), _env.rm(), PIXELS*sizeof(Pixel_rgb888) };
+	Attached_ram_dataspace _ref_ds   { _env.ram(), _env.rm(), PIXELS*sizeof(Pixel_rgb888) };
+	Attached_ram_dataspace _src_ds   { _env.ram(), _env.rm(), PIXELS*sizeof(Pixel_rgb888) };
+	Attached_ram_dataspace _alpha_ds { _env.ram(), _env.rm(), PIXELS };
+
+	Pixel_rgb888  *_dst()   { return _dst_ds.local_addr<Pixel_rgb888>(); }
+	Pixel_rgb888  *_ref()   { return _ref_ds.local_addr<Pixel_rgb888>(); }
+	Pixel_rgb888  *_src()   { return _src_ds.local_addr<Pixel_rgb888>(); }
+	unsigned char *_alpha() { return _alpha_ds.local_addr<unsigned char>(); }
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void _init_buffers()
+	{
+		for (unsigned i = 0; i < PIXELS; i++) {
+			_dst()[i].pixel = _ref()[i].pixel = _random();
+			_src()[i].pixel = _random();
+
+			/* mix of transparent, opaque, and translucent pixels */
+			unsigned const r = _random() % 4;
+			_alpha()[i] = (r == 0) ? 0 : (r == 1) ? 255 : (unsigned char)_random();
+		}
+	}
+
+	/**
+	 * Apply 'fn' to each line of the surface as often as possible
+	 *
+	 * \return  megapixels per second
+	 */
+	template <typename FN>
+	uint64_t _measure(FN const &fn)
+	{
+		uint64_t pixels = 0;
+		uint64_t const start_ms = _timer.elapsed_ms();
+		uint64_t       end_ms   = start_ms;
+		for (; end_ms - start_ms < DURATION_MS; end_ms = _timer.elapsed_ms()) {
+			fn();
+			pixels += PIXELS;
+		}
+		return pixels/1000/(end_ms - start_ms);
+	}
+
+	void _apply(Pixel_kernels::Ops const &ops, unsigned op, Pixel_rgb888 *dst)
+	{
+		Pixel_rgb888 const pixel(0x12, 0x34, 0x56);
+
+		for (unsigned y = 0; y < H; y++) {
+			Pixel_rgb888        * const d = dst       + y*W;
+			Pixel_rgb888  const * const s = _src()    + y*W;
+			unsigned char const * const a = _alpha()  + y*W;
+
+			switch (op) {
+			case 0: ops.fill (d, W, pixel);      break;
+			case 1: ops.mix  (d, W, pixel, 100); break;
+			case 2: ops.blend(d, s, a, W);       break;
+			case 3: ops.copy (d, s, W);          break;
+			}
+		}
+	}
+
+	bool _verify(Pixel_kernels::Ops const &ops)
+	{
+		for (unsigned op = 0; op < 4; op++) {
+			_apply(Pixel_kernels::scalar_ops(), op, _ref());
+			_apply(ops, op, _dst());
+			if (memcmp(_ref(), _dst(), PIXELS*sizeof(Pixel_rgb888))) {
+				error(ops.name, ": result of operation ", op, " differs from scalar kernel");
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void _bench(Pixel_kernels::Ops const &ops)
+	{
+		if (!_verify(ops))
+			throw Exception();
+
+		uint64_t mpix_s[4];
+		for (unsigned op = 0; op < 4; op++)
+			mpix_s[op] = _measure([&] { _apply(ops, op, _dst()); });
+
+		log(ops.name, ": fill ",  mpix_s[0], " MPix/s, ",
+		                "mix ",   mpix_s[1], " MPix/s, ",
+		                "blend ", mpix_s[2], " MPix/s, ",
+		                "copy ",  mpix_s[3], " MPix/s");
+	}
+
+	void _bench_painters()
+	{
+		typedef Surface_base::Rect  Rect;
+		typedef Surface_base::Point Point;
+		typedef Surface_base::Area  Area;
+
+		Area const area(W, H);
+
+		Surface<Pixel_rgb888> surface(_dst(), area);
+		Texture<Pixel_rgb888> texture(_src(), _alpha(), area);
+
+		uint64_t const box_fill = _measure([&] {
+			Box_painter::paint(surface, Rect(Point(0, 0), area),
+			                   Color(0x12, 0x34, 0x56)); });
+
+		uint64_t const box_mix = _measure([&] {
+			Box_painter::paint(surface, Rect(Point(0, 0), area),
+			                   Color(0x12, 0x34, 0x56, 100)); });
+
+		uint64_t const texture_blend = _measure([&] {
+			Texture_painter::paint(surface, texture, Color(0, 0, 0), Point(0, 0),
+			                       Texture_painter::SOLID, true); });
+
+		log("painters (", Pixel_kernels::ops().name, "): ",
+		    "box ",         box_fill,      " MPix/s, ",
+		    "translucent box ", box_mix,   " MPix/s, ",
+		    "texture ",     texture_blend, " MPix/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- painter benchmark ---");
+
+		_init_buffers();
+
+		_bench(Pixel_kernels::scalar_ops());
+
+		if (Pixel_kernels::vector_ops())
+			_bench(*Pixel_kernels::vector_ops());
+
+		if (Pixel_kernels::avx2_ops())
+			_bench(*Pixel_kernels::avx2_ops());
+
+		_bench_painters();
+
+		log("--- painter benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-painter_bench
+SRC_CC = main.cc
+LIBS   = base blit
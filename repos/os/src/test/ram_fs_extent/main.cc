@@ -0,0 +1,223 @@
+/*
+ * \brief  Test and benchmark of the RAM fs extent data structure
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test applies a pseudo-random sequence of writes, reads, and truncations
+ * to an extent map and compares the content with a flat reference buffer.
+ * The benchmark writes and reads a large file sequentially, once stored in
+ * extents and once stored in the chunk hierarchy used by the VFS RAM file
+ * system before, and reports the number of allocations and the throughput.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/heap.h>
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <ram_fs/extent.h>
+#include <ram_fs/chunk.h>
+#include <ram_fs/param.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace File_system;
+	using namespace Ram_fs;
+
+	struct Counting_allocator;
+	struct Main;
+
+	typedef Chunk      <num_level_3_entries()>                Chunk_level_3;
+	typedef Chunk_index<num_level_2_entries(), Chunk_level_3> Chunk_level_2;
+	typedef Chunk_index<num_level_1_entries(), Chunk_level_2> Chunk_level_1;
+	typedef Chunk_index<num_level_0_entries(), Chunk_level_1> Chunk_level_0;
+}
+
+
+struct Test::Counting_allocator : Allocator
+{
+	Allocator &_wrapped;
+
+	size_t   sum    { 0 };
+	unsigned allocs { 0 };
+
+	Counting_allocator(Allocator &wrapped) : _wrapped(wrapped) { }
+
+	bool alloc(size_t size, void **out_addr) override
+	{
+		bool const result = _wrapped.alloc(size, out_addr);
+		if (result) {
+			sum += size;
+			allocs++;
+		}
+		return result;
+	}
+
+	void free(void *addr, size_t size) override
+	{
+		sum -= size;
+		_wrapped.free(addr, size);
+	}
+
+	size_t overhead(size_t size) const override { return _wrapped.overhead(size); }
+	bool   need_size_for_free()  const override { return true; }
+};
+
+
+struct Test::Main
+{
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Timer::Connection       _timer  { _env };
+
+	struct Failed : Genode::Exception { };
+
+	char *_alloc_buf(size_t size) {
+		return (char *)static_cast<Allocator &>(_heap).alloc(size); }
+
+	/* simple linear congruential generator for reproducible patterns */
+	unsigned _seed = 42;
+	unsigned _random() { _seed = _seed*1103515245 + 12345; return _seed >> 8; }
+
+	void _test_random_access()
+	{
+		enum { FILE_SIZE = 256*1024, MAX_LEN = 12*1024, ROUNDS = 4000 };
+
+		Counting_allocator alloc { _heap };
+
+		char * const reference = _alloc_buf(FILE_SIZE);
+		char * const buf       = _alloc_buf(FILE_SIZE);
+		char * const pattern   = _alloc_buf(MAX_LEN);
+
+		memset(reference, 0, FILE_SIZE);
+
+		{
+			Extent_map extents { alloc };
+			file_size_t length = 0;
+
+			for (unsigned i = 0; i < ROUNDS; i++) {
+
+				size_t     const len    = 1 + _random() % MAX_LEN;
+				seek_off_t const offset = _random() % (FILE_SIZE - len);
+
+				switch (_random() % 8) {
+
+				case 0:
+				{
+					/* truncate */
+					file_size_t const size = min(length, (file_size_t)offset);
+					if (size < extents.used_size())
+						extents.truncate(size);
+					memset(reference + size, 0, FILE_SIZE - size);
+					length = size;
+					break;
+				}
+
+				default:
+
+					for (size_t j = 0; j < len; j++)
+						pattern[j] = (char)(1 + (i + j) % 251);
+
+					extents.write(pattern, len, offset);
+					memcpy(reference + offset, pattern, len);
+					length = max(length, (file_size_t)(offset + len));
+					break;
+				}
+
+				/* compare random range */
+				size_t     const cmp_len    = 1 + _random() % MAX_LEN;
+				seek_off_t const cmp_offset = _random() % (FILE_SIZE - cmp_len);
+
+				extents.read(buf, cmp_len, cmp_offset);
+				if (memcmp(buf, reference + cmp_offset, cmp_len)) {
+					error("content mismatch in round ", i, " at ", cmp_offset);
+					throw Failed();
+				}
+			}
+
+			extents.read(buf, FILE_SIZE, 0);
+			if (memcmp(buf, reference, FILE_SIZE)) {
+				error("content mismatch of final state");
+				throw Failed();
+			}
+
+			log("random access: ", (unsigned)ROUNDS, " rounds, ",
+			    extents.count(), " extents, ", alloc.sum/1024, " KiB allocated");
+		}
+
+		_heap.free(pattern,   MAX_LEN);
+		_heap.free(buf,       FILE_SIZE);
+		_heap.free(reference, FILE_SIZE);
+
+		if (alloc.sum) {
+			error("leaked ", alloc.sum, " bytes");
+			throw Failed();
+		}
+	}
+
+	template <typename STORAGE>
+	void _bench_sequential(char const *name, STORAGE &storage,
+	                       Counting_allocator &alloc, size_t file_size,
+	                       size_t io_size)
+	{
+		char * const buf = _alloc_buf(io_size);
+		memset(buf, 0x55, io_size);
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (size_t offset = 0; offset < file_size; offset += io_size)
+			storage.write(buf, io_size, offset);
+
+		uint64_t const write_us = _timer.elapsed_us();
+
+		for (size_t offset = 0; offset < file_size; offset += io_size)
+			storage.read(buf, io_size, offset);
+
+		uint64_t const read_us = _timer.elapsed_us();
+
+		auto rate = [&] (uint64_t us) { return us ? file_size/us : 0; };
+
+		log(name, ": ", file_size/1024, " KiB, ", alloc.allocs, " allocations, ",
+		    alloc.sum/1024, " KiB allocated, write ", rate(write_us - start_us),
+		    " MB/s, read ", rate(read_us - write_us), " MB/s");
+
+		_heap.free(buf, io_size);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RAM filesystem extent test ---");
+
+		_test_random_access();
+
+		size_t const file_size =
+			_config.xml().attribute_value("file_size", Number_of_bytes(64*1024*1024));
+		size_t const io_size =
+			_config.xml().attribute_value("io_size", Number_of_bytes(64*1024));
+
+		{
+			Counting_allocator alloc { _heap };
+			Extent_map extents { alloc };
+			_bench_sequential("extents", extents, alloc, file_size, io_size);
+		}
+		{
+			Counting_allocator alloc { _heap };
+			Chunk_level_0 chunks { alloc, 0 };
+			_bench_sequential("chunks ", chunks, alloc, file_size, io_size);
+		}
+
+		log("--- RAM filesystem extent test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,171 @@
+/*
+ * \brief  Test and benchmark of lossless trace-buffer streaming
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * A producer thread logs sequence-numbered entries of varying size into a
+ * trace buffer while the main thread consumes them in batches. In lossless
+ * mode, the test verifies that the consumer observes each entry exactly once
+ * and in order, and that the drop counter accounts for all entries refused
+ * by the buffer. For comparison, the default overwriting mode reports the
+ * number of entries lost by wrapping.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/log.h>
+#include <base/thread.h>
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/trace/buffer.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+namespace Test {
+	struct Producer;
+	struct Main;
+	using namespace Genode;
+}
+
+
+struct Test::Producer : Thread
+{
+	Trace::Buffer       &_buffer;
+	unsigned long const  _entries;
+	bool          const  _retry;
+
+	unsigned long refused { 0 };
+
+	Producer(Env &env, Trace::Buffer &buffer, unsigned long entries, bool retry)
+	:
+		Thread(env, "producer", 8*1024),
+		_buffer(buffer), _entries(entries), _retry(retry)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned long seq = 1; seq <= _entries; ) {
+
+			/* vary the entry size to exercise the wrap-around handling */
+			size_t const len = sizeof(seq) + (seq % 7)*8;
+
+			char * const dst = _buffer.reserve(len);
+			if (!dst) {
+				refused++;
+				if (!_retry)
+					seq++;
+				continue;
+			}
+
+			memcpy(dst, &seq, sizeof(seq));
+			_buffer.commit(len);
+			seq++;
+		}
+	}
+};
+
+
+struct Test::Main
+{
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Timer::Connection       _timer  { _env };
+
+	size_t const _buffer_size {
+		_config.xml().attribute_value("buffer", Number_of_bytes(64*1024)) };
+
+	unsigned long const _entries {
+		_config.xml().attribute_value("entries", 1000000UL) };
+
+	unsigned const _batch {
+		_config.xml().attribute_value("batch", 64U) };
+
+	struct Failed : Exception { };
+
+	void _stream(char const *mode, bool retry)
+	{
+		Attached_ram_dataspace ds { _env.ram(), _env.rm(), _buffer_size };
+
+		Trace::Buffer &buffer = *ds.local_addr<Trace::Buffer>();
+		buffer.init(_buffer_size);
+		buffer.stream_lossless();
+
+		Producer producer { _env, buffer, _entries, retry };
+
+		uint64_t const start_us = _timer.elapsed_us();
+		producer.start();
+
+		unsigned long consumed = 0, last = 0, batches = 0;
+		bool in_order = true;
+
+		auto consume = [&] () {
+			return buffer.for_each_new_entry([&] (Trace::Buffer::Entry const &e) {
+				unsigned long seq = 0;
+				memcpy(&seq, e.data(), sizeof(seq));
+				if (seq <= last || (retry && seq != last + 1))
+					in_order = false;
+				last = seq;
+				consumed++;
+			}, _batch);
+		};
+
+		while (last < _entries && (retry || consumed + buffer.dropped() < _entries))
+			if (consume())
+				batches++;
+
+		producer.join();
+		consume();
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log(mode, ": consumed=", consumed, " dropped=", buffer.dropped(),
+		    " refused=", producer.refused, " batches=", batches, " in ",
+		    duration_us/1000, " ms (",
+		    duration_us ? consumed*1000*1000/duration_us : 0, " entries/s)");
+
+		if (!in_order || consumed + buffer.dropped() != _entries
+		 || (retry && consumed != _entries)) {
+			error(mode, ": lost or reordered entries");
+			throw Failed();
+		}
+	}
+
+	void _overwrite()
+	{
+		Attached_ram_dataspace ds { _env.ram(), _env.rm(), _buffer_size };
+
+		Trace::Buffer &buffer = *ds.local_addr<Trace::Buffer>();
+		buffer.init(_buffer_size);
+
+		Producer producer { _env, buffer, _entries, false };
+
+		uint64_t const start_us = _timer.elapsed_us();
+		producer.start();
+		producer.join();
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log("overwrite: produced=", _entries, " wrapped=", buffer.wrapped(),
+		    " in ", duration_us/1000, " ms");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- trace-buffer test ---");
+
+		_overwrite();
+		_stream("lossless, retrying producer", true);
+		_stream("lossless, dropping producer", false);
+
+		log("--- trace-buffer test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,164 @@
+/*
+ * \brief  Benchmark of open/stat rates depending on the VFS fan-out
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * For each configured fan-out, the test creates a VFS with the given number
+ * of sibling directories at the root and the given number of sibling files
+ * within '/dev'. It measures the rates of stat and open/close operations on
+ * '/dev/zero' and of stat operations on a path that does not exist.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <vfs/simple_env.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <util/xml_generator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	struct Main;
+	struct Fan_out_benchmark;
+	using namespace Genode;
+}
+
+
+struct Test::Fan_out_benchmark
+{
+	typedef Vfs::Directory_service Ds;
+
+	Env               &_env;
+	Allocator         &_alloc;
+	Timer::Connection &_timer;
+	unsigned     const _fan_out;
+
+	size_t const _vfs_config_size = 1024 + _fan_out*128;
+	char * const _vfs_config      = (char *)_alloc.alloc(_vfs_config_size);
+
+	Xml_node _generate_vfs_config()
+	{
+		typedef String<32> Name;
+
+		Xml_generator xml(_vfs_config, _vfs_config_size, "vfs", [&] () {
+
+			for (unsigned i = 0; i < _fan_out; i++)
+				xml.node("dir", [&] () {
+					xml.attribute("name", Name("dir_", i));
+					xml.node("null", [&] () { });
+				});
+
+			xml.node("dir", [&] () {
+				xml.attribute("name", "dev");
+
+				for (unsigned i = 0; i < _fan_out; i++)
+					xml.node("null", [&] () {
+						xml.attribute("name", Name("null_", i)); });
+
+				xml.node("zero", [&] () { });
+			});
+		});
+
+		return Xml_node(_vfs_config);
+	}
+
+	Vfs::Simple_env _vfs_env { _env, _alloc, _generate_vfs_config() };
+
+	Vfs::File_system &_root() { return _vfs_env.root_dir(); }
+
+	template <typename FN>
+	void _measure(char const *what, unsigned rounds, FN const &fn)
+	{
+		unsigned long failed = 0;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < rounds; i++)
+			if (!fn())
+				failed++;
+
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ull);
+
+		log("fan-out ", _fan_out, ": ", what, " ",
+		    ((uint64_t)rounds*1000*1000)/duration_us, " ops/s, ",
+		    (duration_us*1000)/max((uint64_t)rounds, 1ull), " ns/op");
+
+		if (failed)
+			error("fan-out ", _fan_out, ": ", failed, " ", what, " operations failed");
+	}
+
+	Fan_out_benchmark(Env &env, Allocator &alloc, Timer::Connection &timer,
+	                  unsigned fan_out)
+	:
+		_env(env), _alloc(alloc), _timer(timer), _fan_out(fan_out)
+	{ }
+
+	~Fan_out_benchmark() { _alloc.free(_vfs_config, _vfs_config_size); }
+
+	void run(unsigned rounds)
+	{
+		_measure("stat", rounds, [&] () {
+			Ds::Stat stat { };
+			return _root().stat("/dev/zero", stat) == Ds::STAT_OK; });
+
+		_measure("stat (missing)", rounds, [&] () {
+			Ds::Stat stat { };
+			return _root().stat("/missing/file", stat) == Ds::STAT_ERR_NO_ENTRY; });
+
+		_measure("open/close", rounds, [&] () {
+			Vfs::Vfs_handle *handle = nullptr;
+			if (_root().open("/dev/zero", Ds::OPEN_MODE_RDONLY, &handle, _alloc)
+			    != Ds::OPEN_OK)
+				return false;
+
+			handle->close();
+			return true;
+		});
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Fan_out_benchmark(Fan_out_benchmark const &);
+		Fan_out_benchmark &operator = (Fan_out_benchmark const &);
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- VFS fan-out benchmark ---");
+
+		unsigned const rounds = _config.xml().attribute_value("rounds", 100000u);
+
+		_config.xml().for_each_sub_node("fan_out", [&] (Xml_node node) {
+
+			Fan_out_benchmark benchmark(_env, _heap, _timer,
+			                            node.attribute_value("value", 1u));
+			benchmark.run(rounds);
+		});
+
+		log("--- VFS fan-out benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-vfs_dir_routing
+SRC_CC = main.cc
+LIBS   = base vfs
@@ -0,0 +1,214 @@
+/*
+ * \brief  Benchmark of the aggregate throughput of concurrent file-system clients
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The component opens one file-system session per configured client, each
+ * with a distinct label, and keeps the packet stream of each session
+ * saturated with write requests to a client-specific file. Once all clients
+ * transferred the configured amount of data, the per-client and the
+ * aggregate throughput are reported. Depending on the session policies of
+ * the file-system server, the sessions are served by one or by several
+ * entrypoints.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/registry.h>
+#include <base/component.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <file_system_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	struct Client;
+	struct Main;
+	using namespace Genode;
+}
+
+
+struct Test::Client
+{
+	typedef String<32> Name;
+
+	struct Completion_handler : Interface
+	{
+		virtual void client_completed(Client &) = 0;
+	};
+
+	Env                &_env;
+	Name         const  _name;
+	Completion_handler &_completion_handler;
+
+	size_t const _packet_size;
+	size_t const _file_size;
+	size_t const _total_bytes;
+
+	Allocator_avl _tx_alloc;
+
+	File_system::Connection _fs;
+
+	File_system::Session::Tx::Source &_tx { *_fs.tx() };
+
+	File_system::Dir_handle  _dir  { _fs.dir("/", false) };
+	File_system::File_handle _file { _fs.file(_dir, _name.string(), File_system::READ_WRITE, true) };
+
+	Signal_handler<Client> _ack_handler { _env.ep(), *this, &Client::_handle_ack };
+
+	size_t _submitted_bytes { 0 };
+	size_t _acked_bytes     { 0 };
+
+	uint64_t _start_us { 0 };
+	uint64_t _end_us   { 0 };
+
+	void _submit(File_system::Packet_descriptor const &buffer)
+	{
+		File_system::Packet_descriptor const packet(
+			buffer, _file, File_system::Packet_descriptor::WRITE,
+			_packet_size, _submitted_bytes % _file_size);
+
+		_tx.submit_packet(packet);
+		_submitted_bytes += _packet_size;
+	}
+
+	void _handle_ack();
+
+	Client(Env &env, Allocator &alloc, Name const &name,
+	       Completion_handler &completion_handler,
+	       size_t packet_size, size_t file_size, size_t total_bytes,
+	       size_t tx_buf_size)
+	:
+		_env(env), _name(name), _completion_handler(completion_handler),
+		_packet_size(packet_size), _file_size(file_size),
+		_total_bytes(total_bytes),
+		_tx_alloc(&alloc),
+		_fs(env, _tx_alloc, name.string(), "/", true, tx_buf_size)
+	{
+		_fs.sigh_ack_avail(_ack_handler);
+	}
+
+	void start(uint64_t now_us)
+	{
+		_start_us = now_us;
+
+		/* stuff the packet stream */
+		while (_submitted_bytes < _total_bytes && _tx.ready_to_submit()) {
+			try { _submit(_tx.alloc_packet(_packet_size)); }
+			catch (File_system::Session::Tx::Source::Packet_alloc_failed) { break; }
+		}
+	}
+
+	bool completed() const { return _acked_bytes >= _total_bytes; }
+
+	void completed_at(uint64_t now_us) { _end_us = now_us; }
+
+	uint64_t duration_us() const { return _end_us - _start_us; }
+
+	size_t bytes() const { return _acked_bytes; }
+
+	Name const &name() const { return _name; }
+};
+
+
+void Test::Client::_handle_ack()
+{
+	while (_tx.ack_avail()) {
+
+		File_system::Packet_descriptor const packet = _tx.get_acked_packet();
+
+		if (!packet.succeeded())
+			warning(_name, ": write failed");
+
+		_acked_bytes += packet.length();
+
+		if (_submitted_bytes < _total_bytes) {
+			_submit(packet);
+			continue;
+		}
+
+		_tx.release_packet(packet);
+
+		if (completed())
+			_completion_handler.client_completed(*this);
+	}
+}
+
+
+struct Test::Main : Client::Completion_handler
+{
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Timer::Connection       _timer  { _env };
+
+	Xml_node const _config_xml = _config.xml();
+
+	unsigned const _num_clients { _config_xml.attribute_value("clients", 4U) };
+
+	size_t const _packet_size {
+		_config_xml.attribute_value("packet_size", Number_of_bytes(16*1024)) };
+
+	size_t const _file_size {
+		_config_xml.attribute_value("file_size", Number_of_bytes(1024*1024)) };
+
+	size_t const _total_bytes {
+		_config_xml.attribute_value("bytes", Number_of_bytes(64*1024*1024)) };
+
+	size_t const _tx_buf_size {
+		_config_xml.attribute_value("tx_buf_size", Number_of_bytes(256*1024)) };
+
+	Registry<Registered_no_delete<Client> > _clients { };
+
+	unsigned _completed { 0 };
+
+	uint64_t _start_us { 0 };
+
+	void client_completed(Client &client) override
+	{
+		client.completed_at(_timer.elapsed_us());
+
+		log(client.name(), ": ", client.bytes()/1024, " KiB in ",
+		    client.duration_us()/1000, " ms (",
+		    client.duration_us() ? client.bytes()/client.duration_us() : 0,
+		    " MB/s)");
+
+		if (++_completed < _num_clients)
+			return;
+
+		uint64_t const duration_us = _timer.elapsed_us() - _start_us;
+		size_t   const bytes       = _num_clients*_total_bytes;
+
+		log("aggregate: ", _num_clients, " clients, ", bytes/1024, " KiB in ",
+		    duration_us/1000, " ms (",
+		    duration_us ? bytes/duration_us : 0, " MB/s)");
+
+		log("--- VFS server benchmark finished ---");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- VFS server benchmark ---");
+
+		for (unsigned i = 0; i < _num_clients; i++)
+			new (_heap)
+				Registered_no_delete<Client>(_clients, _env, _heap,
+				                   Client::Name("client-", i), *this,
+				                   _packet_size, _file_size, _total_bytes,
+				                   _tx_buf_size);
+
+		_start_us = _timer.elapsed_us();
+
+		_clients.for_each([&] (Client &client) { client.start(_start_us); });
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-vfs_server_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,186 @@
+/*
+ * \brief  Benchmark of path lookups in the VFS tar file system
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * For each configured archive, the test collects all paths contained in the
+ * archive and measures the time needed to stat each of them repeatedly. The
+ * archives are expected to differ in their number of entries so that the
+ * output shows how the lookup time scales with the archive size.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <vfs/simple_env.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <util/xml_generator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	struct Main;
+	struct Archive_benchmark;
+	using namespace Genode;
+}
+
+
+struct Test::Archive_benchmark
+{
+	typedef Vfs::Directory_service::Dirent      Dirent;
+	typedef Vfs::Directory_service::Dirent_type Dirent_type;
+	typedef String<64> Name;
+
+	struct Entry : List<Entry>::Element
+	{
+		Vfs::Absolute_path const path;
+
+		Entry(Vfs::Absolute_path const &path) : path(path) { }
+	};
+
+	Env               &_env;
+	Allocator         &_alloc;
+	Timer::Connection &_timer;
+	Name         const _name;
+
+	char _vfs_config[256] { };
+
+	Xml_node _generate_vfs_config()
+	{
+		Xml_generator xml(_vfs_config, sizeof(_vfs_config), "vfs", [&] () {
+			xml.node("tar", [&] () { xml.attribute("name", _name); }); });
+
+		return Xml_node(_vfs_config);
+	}
+
+	Vfs::Simple_env _vfs_env { _env, _alloc, _generate_vfs_config() };
+
+	Vfs::File_system &_root() { return _vfs_env.root_dir(); }
+
+	List<Entry>   _entries     { };
+	unsigned long _num_entries = 0;
+
+	void _collect(Vfs::Absolute_path const &dir_path)
+	{
+		Vfs::Vfs_handle *handle = nullptr;
+		if (_root().opendir(dir_path.base(), false, &handle, _alloc)
+		    != Vfs::Directory_service::OPENDIR_OK)
+			return;
+
+		for (Vfs::file_size i = 0; ; i++) {
+
+			Dirent dirent { };
+			Vfs::file_size out_count = 0;
+
+			handle->seek(i*sizeof(Dirent));
+			handle->fs().queue_read(handle, sizeof(Dirent));
+			handle->fs().complete_read(handle, (char *)&dirent,
+			                           sizeof(Dirent), out_count);
+
+			if (out_count < sizeof(Dirent) || dirent.type == Dirent_type::END)
+				break;
+
+			dirent.sanitize();
+
+			Vfs::Absolute_path path(dirent.name.buf, dir_path.base());
+
+			_entries.insert(new (_alloc) Entry(path));
+			_num_entries++;
+
+			if (dirent.type == Dirent_type::DIRECTORY)
+				_collect(path);
+		}
+
+		handle->close();
+	}
+
+	Archive_benchmark(Env &env, Allocator &alloc, Timer::Connection &timer,
+	                  Name const &name)
+	:
+		_env(env), _alloc(alloc), _timer(timer), _name(name)
+	{
+		_collect(Vfs::Absolute_path("/"));
+	}
+
+	~Archive_benchmark()
+	{
+		while (Entry *entry = _entries.first()) {
+			_entries.remove(entry);
+			destroy(_alloc, entry);
+		}
+	}
+
+	void run(unsigned rounds)
+	{
+		unsigned long failed = 0;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned round = 0; round < rounds; round++) {
+			for (Entry const *e = _entries.first(); e; e = e->next()) {
+				Vfs::Directory_service::Stat stat { };
+				if (_root().stat(e->path.base(), stat)
+				    != Vfs::Directory_service::STAT_OK)
+					failed++;
+			}
+		}
+
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ull);
+		uint64_t const lookups     = (uint64_t)_num_entries*rounds;
+
+		log(_name, ": ", _num_entries, " entries, ",
+		    lookups, " lookups in ", duration_us, " us, ",
+		    (lookups*1000*1000)/duration_us, " lookups/s, ",
+		    (duration_us*1000)/max(lookups, 1ull), " ns/lookup");
+
+		if (failed)
+			error(_name, ": ", failed, " lookups failed");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Archive_benchmark(Archive_benchmark const &);
+		Archive_benchmark &operator = (Archive_benchmark const &);
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- VFS tar lookup benchmark ---");
+
+		unsigned const rounds = _config.xml().attribute_value("rounds", 10u);
+
+		_config.xml().for_each_sub_node("archive", [&] (Xml_node archive) {
+
+			Archive_benchmark::Name const name =
+				archive.attribute_value("name", Archive_benchmark::Name());
+
+			Archive_benchmark benchmark(_env, _heap, _timer, name);
+			benchmark.run(rounds);
+		});
+
+		log("--- VFS tar lookup benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-vfs_tar_lookup
+SRC_CC = main.cc
+LIBS   = base vfs